@@ -2,7 +2,6 @@
 #include "ActMergerData.h"
 #include "ActModularData.h"
 #include "ActSilData.h"
-#include "ActTPCData.h"
 
 #include <ROOT/RDataFrame.hxx>
 
@@ -11,48 +10,29 @@
 #include "TLegend.h"
 #include "TMath.h"
 
+#include "../../PostAnalysis/ChainUtils.h"
+#include "../../PostAnalysis/ClusterSummary.h"
+
 void plotELossBeam_20Ne()
 {
     ROOT::EnableImplicitMT();
     ActRoot::DataManager dataman {"../../configs/data.conf", ActRoot::ModeType::EReadSilMod};
     auto chain {dataman.GetChain()};
-    auto chain2 {dataman.GetChain(ActRoot::ModeType::EReadTPC)};
+    // Cluster-stage clusters (EReadTPC) as before the summary, from runClusterSummary.cxx(dataconf, "Cluster")
+    auto chain2 {
+        ChainUtils::GetSidecar(chain.get(), "../../RootFiles/Summary/", "SummaryCluster_Run_", "SummaryTree")};
     chain->AddFriend(chain2.get());
     ROOT::RDataFrame df {*chain};
 
     // Create columns for E_Loss and E_Beam
     auto df_gated1 = df.Filter([](ActRoot::ModularData& m) { return m.Get("GATCONF") == 64; }, {"ModularData"});
 
-    auto df_gated = df_gated1.Filter([](ActRoot::TPCData& d) { return d.fClusters.size() != 0; }, {"TPCData"});
+    auto df_gated = df_gated1.Filter("NClusters != 0");
 
     auto df_final = df_gated
-                        .Define("E_Loss",
-                                [](ActRoot::TPCData& d)
-                                {
-                                    auto voxelsBeam {d.fClusters[0].GetRefToVoxels()};
-                                    double DE {0};
-                                    for(auto v : voxelsBeam)
-                                    {
-                                        if(v.GetPosition().X() < 10)
-                                        {
-                                            DE += v.GetCharge();
-                                        }
-                                    }
-                                    return DE;
-                                },
-                                {"TPCData"})
-                        .Define("E_Beam",
-                                [](ActRoot::TPCData& d)
-                                {
-                                    auto voxelsBeam {d.fClusters[0].GetRefToVoxels()};
-                                    double E {0};
-                                    for(auto v : voxelsBeam)
-                                    {
-                                        E += v.GetCharge();
-                                    }
-                                    return E;
-                                },
-                                {"TPCData"});
+                        .Define("E_Loss", [](const ROOT::RVecF& qprofile)
+                                { return ClusterSummary::GetQBelow(qprofile, 0, 10); }, {"QProfile"})
+                        .Define("E_Beam", "(double)Q[0]");
 
     auto hDE_E {df_final.Histo1D({"hDE_20Ne", "DE;DE [u.a.]", 100, 0, 1e5}, "E_Loss")};
     // Save histos in files
@@ -3,7 +3,6 @@
 #include "ActModularData.h"
 #include "ActSilData.h"
 #include "ActSilSpecs.h"
-#include "ActTPCData.h"
 #include "ActTypes.h"
 
 #include "ROOT/RDataFrame.hxx"
@@ -13,14 +12,14 @@
 #include <fstream>
 #include <memory>
 
+#include "../PostAnalysis/ChainUtils.h"
+#include "../PostAnalysis/EventList.h"
+
 void beta27P()
 {
+    // Beta skim (GATCONF == 512) written by runSkims.cxx
     ActRoot::DataManager dataman {"../configs/data.conf", ActRoot::ModeType::EReadSilMod};
-    auto chain {dataman.GetChain()};
-    auto chainTpc {dataman.GetChain(ActRoot::ModeType::EReadTPC)};
-    auto chainMerger {dataman.GetChain(ActRoot::ModeType::EMerge)};
-    chain->AddFriend(chainTpc.get());
-    chain->AddFriend(chainMerger.get());
+    auto chain {ChainUtils::GetSidecar(dataman.GetChain().get(), "../RootFiles/Skims/", "Beta_Run_", "SkimTree")};
 
     ROOT::RDataFrame d {*chain};
     auto df {d.Define("GATCONF", [](ActRoot::ModularData& mod) { return mod.Get("GATCONF"); }, {"ModularData"})};
@@ -41,12 +40,12 @@ void beta27P()
         },
         {"GATCONF", "SilData"})};
 
-    // Gate on events with a track = proton!
-    auto dfProton {dfGat.Filter([](ActRoot::TPCData& d) { return d.fClusters.size() == 1; }, {"TPCData"})};
+    // Gate on events with a track = proton! (Cluster stage clusters, EReadTPC as before the skim)
+    auto dfProton {dfGat.Filter([](int nclusters) { return nclusters == 1; }, {"ClusterNClusters"})};
 
     // Write events
     std::ofstream streamer {"./Outputs/maybe_betas.dat"};
-    dfProton.Foreach([&](ActRoot::MergerData& mer) { mer.Stream(streamer); }, {"MergerData"});
+    dfProton.Foreach([&](int run, int entry) { EventList::Stream(streamer, run, entry); }, {"fRun", "fEntry"});
     streamer.close();
 
     std::cout << "% proton events: " << (double)(*dfProton.Count()) / (*dfGat.Count()) * 100 << '\n';
@@ -0,0 +1,151 @@
+#include "ActCluster.h"
+#include "ActDataManager.h"
+#include "ActMergerData.h"
+#include "ActTPCData.h"
+#include "ActTypes.h"
+
+#include "ROOT/RDataFrame.hxx"
+
+#include "TCanvas.h"
+#include "TH2.h"
+#include "TMath.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <vector>
+
+#include "../PostAnalysis/HistConfig.h"
+
+using BeamLine = std::array<double, 4>; // y0, z0, ty, tz at X = 0 (pad units)
+
+// Mean and sigma of beam line parameters with iterated clipping: beams off by more than nsigma in any parameter
+// (pile-up, mis-fits, scattered beams) are rejected and the estimate recomputed until no beam is removed
+struct BeamEstimate
+{
+    int fN {};
+    BeamLine fMean {};
+    BeamLine fSigma {};
+
+    BeamEstimate(const std::vector<BeamLine>& beams, double nsigma = 3, int maxIter = 20)
+    {
+        std::vector<const BeamLine*> kept;
+        for(const auto& b : beams)
+            kept.push_back(&b);
+        for(int iter = 0; iter < maxIter; iter++)
+        {
+            Compute(kept);
+            auto before {kept.size()};
+            kept.erase(std::remove_if(kept.begin(), kept.end(),
+                                      [&](const BeamLine* b)
+                                      {
+                                          for(int i = 0; i < 4; i++)
+                                              if(std::abs((*b)[i] - fMean[i]) > nsigma * fSigma[i])
+                                                  return true;
+                                          return false;
+                                      }),
+                       kept.end());
+            if(kept.size() == before || kept.size() < 2)
+                break;
+        }
+        Compute(kept);
+    }
+
+private:
+    void Compute(const std::vector<const BeamLine*>& beams)
+    {
+        fN = beams.size();
+        for(int i = 0; i < 4; i++)
+        {
+            double sum {}, sum2 {};
+            for(const auto* b : beams)
+            {
+                sum += (*b)[i];
+                sum2 += (*b)[i] * (*b)[i];
+            }
+            fMean[i] = fN ? sum / fN : 0;
+            fSigma[i] = fN ? std::sqrt(std::max(0., sum2 / fN - fMean[i] * fMean[i])) : 0;
+        }
+    }
+};
+
+void buildBeamModel()
+{
+    ActRoot::DataManager dataman {"../configs/data.conf", ActRoot::ModeType::EMerge};
+    auto chain {dataman.GetChain()};
+    auto chainFilter {dataman.GetChain(ActRoot::ModeType::EFilter)};
+    chain->AddFriend(chainFilter.get());
+
+    ROOT::EnableImplicitMT();
+    ROOT::RDataFrame df {*chain};
+
+    // Beam line at X = 0
+    auto def {df.Filter("fBeamIdx != -1")
+                  .Define("BeamPars",
+                          [](int beamIdx, ActRoot::TPCData& tpc)
+                          {
+                              std::vector<double> ret(4, NAN);
+                              const auto& line {tpc.fClusters[beamIdx].GetLine()};
+                              auto dir {line.GetDirection()};
+                              if(dir.X() == 0)
+                                  return ret;
+                              auto p {line.GetPoint()};
+                              ret[2] = dir.Y() / dir.X();
+                              ret[3] = dir.Z() / dir.X();
+                              ret[0] = p.Y() - ret[2] * p.X();
+                              ret[1] = p.Z() - ret[3] * p.X();
+                              return ret;
+                          },
+                          {"fBeamIdx", "TPCData"})
+                  .Filter([](const std::vector<double>& v) { return std::isfinite(v[0]); }, {"BeamPars"})};
+
+    // Emittance plots, in pad units like the model
+    auto hZThetaZ {def.Define("Z0", "BeamPars[1]")
+                       .Define("ThetaZ", "TMath::ATan(BeamPars[3]) * TMath::RadToDeg()")
+                       .Histo2D(HistConfig::ZThetaZPads, "Z0", "ThetaZ")};
+    auto hYPhiY {def.Define("Y0", "BeamPars[0]")
+                     .Define("PhiY", "TMath::ATan(BeamPars[2]) * TMath::RadToDeg()")
+                     .Histo2D(HistConfig::YPhiYPads, "Y0", "PhiY")};
+
+    // Collect per run and slot
+    std::vector<std::map<int, std::vector<BeamLine>>> slots(df.GetNSlots());
+    def.ForeachSlot([&](unsigned int slot, int run, const std::vector<double>& v)
+                    { slots[slot][run].push_back({v[0], v[1], v[2], v[3]}); },
+                    {"fRun", "BeamPars"});
+
+    std::map<int, std::vector<BeamLine>> beams;
+    for(const auto& slot : slots)
+        for(const auto& [run, v] : slot)
+        {
+            beams[run].insert(beams[run].end(), v.begin(), v.end());
+            beams[-1].insert(beams[-1].end(), v.begin(), v.end());
+        }
+    std::map<int, BeamEstimate> models;
+    for(const auto& [run, v] : beams)
+        models.emplace(run, BeamEstimate {v});
+
+    // Write: run, N, y0, sy0, z0, sz0, ty, sty, tz, stz
+    std::ofstream streamer {"../Calibrations/Beam/Outputs/beam_model_s2008.dat"};
+    streamer << "# run N Y0 sY0 Z0 sZ0 dY/dX s(dY/dX) dZ/dX s(dZ/dX) [pad units]" << '\n';
+    for(const auto& [run, m] : models)
+    {
+        streamer << run << " " << m.fN;
+        for(int i = 0; i < 4; i++)
+            streamer << " " << m.fMean[i] << " " << m.fSigma[i];
+        streamer << '\n';
+        std::cout << "-> Run " << run << " : " << m.fN << " of " << beams[run].size() << " beams kept" << '\n';
+    }
+    streamer.close();
+    std::cout << "Beam model written for " << models.size() - 1 << " runs" << '\n';
+
+    // Draw
+    auto* c0 {new TCanvas {"c0", "Beam model"}};
+    c0->DivideSquare(2);
+    c0->cd(1);
+    hZThetaZ->DrawClone("colz");
+    c0->cd(2);
+    hYPhiY->DrawClone("colz");
+}
@@ -0,0 +1,90 @@
+#include "ActCluster.h"
+#include "ActDataManager.h"
+#include "ActTPCData.h"
+#include "ActTypes.h"
+
+#include "ROOT/RDataFrame.hxx"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "../PostAnalysis/ChainUtils.h"
+#include "../PostAnalysis/VoxelCodec.h"
+
+// Round trip of runCompactVoxels.cxx: decodes the CompactTree of the first entries and compares it with
+// the Filter TPCData (voxels, Z and charge within their precisions, lines, BeamLike and flags, RPs)
+void checkCompactVoxels(Long64_t entries = 100000)
+{
+    ActRoot::DataManager dataman {"../configs/data.conf", ActRoot::ModeType::EFilter};
+    auto chain {dataman.GetChain()};
+    auto compact {ChainUtils::GetSidecar(chain.get(), "../RootFiles/Compact/", "Compact_Run_", "CompactTree")};
+    chain->AddFriend(compact.get());
+    auto flagNames {VoxelCodec::ReadFlagNames(
+        ChainUtils::GetFileName("../RootFiles/Compact/", "Compact_Run_", ChainUtils::GetRuns(chain.get()).front()))};
+
+    // Range needs a single thread
+    ROOT::RDataFrame d {*chain};
+    auto df {VoxelCodec::DefineTPCData(d.Range(entries), flagNames, "Decoded")};
+
+    using Key = std::tuple<long, long, float>;
+    auto sorted {[](const ActRoot::Cluster& cl)
+                 {
+                     std::vector<std::tuple<long, long, float, float>> ret;
+                     for(const auto& v : cl.GetRefToVoxels())
+                     {
+                         const auto& p {v.GetPosition()};
+                         ret.push_back({std::lround(p.X()), std::lround(p.Y()), static_cast<float>(p.Z()), v.GetCharge()});
+                     }
+                     std::sort(ret.begin(), ret.end(), [](const auto& a, const auto& b)
+                               { return Key {std::get<0>(a), std::get<1>(a), std::get<2>(a)} <
+                                        Key {std::get<0>(b), std::get<1>(b), std::get<2>(b)}; });
+                     return ret;
+                 }};
+
+    long nEntries {}, nBad {};
+    df.Foreach(
+        [&](ActRoot::TPCData& tpc, ActRoot::TPCData& dec, double qPrecision, double zPrecision)
+        {
+            nEntries++;
+            bool ok {tpc.fClusters.size() == dec.fClusters.size() && tpc.fRPs.size() == dec.fRPs.size()};
+            for(std::size_t c = 0; ok && c < tpc.fClusters.size(); c++)
+            {
+                const auto& a {tpc.fClusters[c]};
+                const auto& b {dec.fClusters[c]};
+                auto va {sorted(a)};
+                auto vb {sorted(b)};
+                ok = va.size() == vb.size();
+                for(std::size_t i = 0; ok && i < va.size(); i++)
+                {
+                    auto qa {std::get<3>(va[i])};
+                    ok = std::get<0>(va[i]) == std::get<0>(vb[i]) && std::get<1>(va[i]) == std::get<1>(vb[i]) &&
+                         std::abs(std::get<2>(va[i]) - std::get<2>(vb[i])) <= zPrecision / 2 + 1e-4 &&
+                         (std::abs(qa - std::get<3>(vb[i])) <= qPrecision / 2 || qa / qPrecision > 65535);
+                }
+                const auto& la {a.GetLine()};
+                const auto& lb {b.GetLine()};
+                ok = ok && la.GetPoint() == lb.GetPoint() && la.GetDirection() == lb.GetDirection() &&
+                     la.GetChi2() == lb.GetChi2() && a.GetIsBeamLike() == b.GetIsBeamLike();
+                for(const auto& flag : flagNames)
+                    ok = ok && a.GetFlag(flag) == b.GetFlag(flag);
+            }
+            for(std::size_t r = 0; ok && r < tpc.fRPs.size(); r++)
+                ok = tpc.fRPs[r] == dec.fRPs[r];
+            if(!ok)
+            {
+                nBad++;
+                if(nBad <= 10)
+                    std::cout << "checkCompactVoxels: mismatch in entry " << nEntries - 1 << '\n';
+            }
+        },
+        {"TPCData", "Decoded", "VoxQPrecision", "VoxZPrecision"});
+
+    std::cout << "===== Compact voxels round trip =====" << '\n';
+    std::cout << "-> Entries    : " << nEntries << '\n';
+    std::cout << "-> Mismatches : " << nBad << '\n';
+    std::cout << "=====================================" << '\n';
+}
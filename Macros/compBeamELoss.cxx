@@ -1,5 +1,3 @@
-#include "ActSRIM.h"
-
 #include "TCanvas.h"
 #include "TFile.h"
 #include "TH1.h"
@@ -9,6 +7,9 @@
 #include "TVirtualPad.h"
 
 #include <iostream>
+
+#include "../PostAnalysis/CalibBundle.h"
+
 void compBeamELoss()
 {
     // 20Mg
@@ -19,13 +20,14 @@ void compBeamELoss()
     auto* hna {otherFile->Get<TH1D>("hELoss20Na")};
 
     // Determine 20Na scaling factor
-    ActPhysics::SRIM srim;
-    srim.ReadTable("950", "../Calibrations/SRIM/20Na_950mbar_95-5.txt");
-    srim.ReadTable("800", "../Calibrations/SRIM/20Na_800mbar_95-5.txt");
+    // SRIM tables from the calibration bundle (buildCalibBundle.cxx)
+    CalibBundle::Bundle bundle {"../Calibrations/Bundle/calib_s2008.bin"};
+    CalibBundle::SRIMTable srim950 {bundle, "SRIM/20Na_950mbar_95-5"};
+    CalibBundle::SRIMTable srim800 {bundle, "SRIM/20Na_800mbar_95-5"};
     double length {8 * 2.};
     double Eini {84.8}; // 4.24 MeV/u * 20
-    auto eloss950 {Eini - srim.Slow("950", Eini, length)};
-    auto eloss800 {Eini - srim.Slow("800", Eini, length)};
+    auto eloss950 {Eini - srim950.Slow(Eini, length)};
+    auto eloss800 {Eini - srim800.Slow(Eini, length)};
     auto transPressure {eloss800 / eloss950};
     std::cout << "20Na DeltaE 950: " << eloss950 << '\n';
     std::cout << "20Na DeltaE 800: " << eloss800 << '\n';
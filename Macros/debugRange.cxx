@@ -9,7 +9,12 @@
 
 #include "TCanvas.h"
 
-#include "Math/Vector3Dfwd.h"
+#include "Math/Point3D.h"
+#include "Math/Vector3D.h"
+
+#include <cmath>
+
+#include "../PostAnalysis/DerivedCache.h"
 
 void debugRange()
 {
@@ -20,46 +25,56 @@ void debugRange()
 
     chain->AddFriend(chainFilter.get());
 
+    // Track end of the heavy particle: computed once and cached in ./Outputs/Cache/ (friend keyed by run, entry)
+    DerivedCache cache {"HeavyEnd", "./Outputs/Cache/", {__FILE__, "../configs/data.conf"}};
     ROOT::EnableImplicitMT();
-    ROOT::RDataFrame df {*chain};
+    if(!cache.Exists())
+    {
+        ROOT::RDataFrame build {*chain};
+        auto defBuild {build
+                           .Define("End",
+                                   [](ActRoot::MergerData& m, ActRoot::TPCData& tpc)
+                                   {
+                                       ROOT::Math::XYZPointF proj {NAN, NAN, NAN};
+                                       if(m.fHeavyIdx == -1 || m.fLight.IsL1())
+                                           return proj;
+                                       // Get heavy cluster
+                                       auto heavy {tpc.fClusters[m.fHeavyIdx]};
+                                       heavy.SetUseExtVoxels(true);
+                                       // RP
+                                       auto rp {tpc.fRPs.front()};
+                                       // Line
+                                       auto line {heavy.GetLine()};
+                                       // Align using RP in pad units
+                                       line.AlignUsingPoint(rp);
+                                       // Sort alogn direction
+                                       auto& voxels {heavy.GetRefToVoxels()};
+                                       // std::sort(voxels.begin(), voxels.end());
+                                       heavy.SortAlongDir();
+                                       // Get last
+                                       auto end {heavy.GetVoxels().back().GetPosition()};
+                                       end += ROOT::Math::XYZVectorF {0.5, 0.5, 0.5};
+                                       // Scale point
+                                       end.SetX(end.X() * 2);
+                                       end.SetY(end.Y() * 2);
+                                       end.SetZ(end.Z() * 2.208);
+                                       // Scale line
+                                       line.Scale(2, 2.208);
+                                       // Project
+                                       proj = line.ProjectionPointOnLine(end);
+                                       return proj;
+                                   },
+                                   {"MergerData", "TPCData"})
+                           .Define("EndX", "End.X()")
+                           .Define("EndY", "End.Y()")
+                           .Define("EndZ", "End.Z()")};
+        cache.Build(defBuild, {"EndX", "EndY", "EndZ"});
+    }
+    cache.Attach(chain.get());
 
-    auto gated {
-        df.Filter([](ActRoot::MergerData& m) { return m.fHeavyIdx != -1 && !m.fLight.IsL1(); }, {"MergerData"})};
+    ROOT::RDataFrame df {*chain};
 
-    auto def {gated
-                  .Define("End",
-                          [](ActRoot::MergerData& m, ActRoot::TPCData& tpc)
-                          {
-                              // Get heavy cluster
-                              auto heavy {tpc.fClusters[m.fHeavyIdx]};
-                              heavy.SetUseExtVoxels(true);
-                              // RP
-                              auto rp {tpc.fRPs.front()};
-                              // Line
-                              auto line {heavy.GetLine()};
-                              // Align using RP in pad units
-                              line.AlignUsingPoint(rp);
-                              // Sort alogn direction
-                              auto& voxels {heavy.GetRefToVoxels()};
-                              // std::sort(voxels.begin(), voxels.end());
-                              heavy.SortAlongDir();
-                              // Get last
-                              auto end {heavy.GetVoxels().back().GetPosition()};
-                              end += ROOT::Math::XYZVectorF {0.5, 0.5, 0.5};
-                              // Scale point
-                              end.SetX(end.X() * 2);
-                              end.SetY(end.Y() * 2);
-                              end.SetZ(end.Z() * 2.208);
-                              // Scale line
-                              line.Scale(2, 2.208);
-                              // Project
-                              auto proj {line.ProjectionPointOnLine(end)};
-                              return proj;
-                          },
-                          {"MergerData", "TPCData"})
-                  .Define("EndX", "End.X()")
-                  .Define("EndY", "End.Y()")
-                  .Define("EndZ", "End.Z()")};
+    auto def {df.Filter("fHeavyIdx != -1 && std::isfinite(EndX)")};
 
     // Histograms
     ROOT::RDF::TH1DModel mPos {"hPos", "Position;Pos;Counts", 256, 0, 256};
@@ -0,0 +1,36 @@
+#include "ActDataManager.h"
+#include "ActTypes.h"
+
+#include "TString.h"
+#include "TSystem.h"
+
+#include <string>
+#include <vector>
+
+#include "../PostAnalysis/ChainUtils.h"
+#include "../PostAnalysis/EventLocator.h"
+
+// Print the full record of one event (as in debug_ep_range.dat or maybe_betas.dat) in every stage
+// stages: comma separated subset of Raw, Cluster, Data, Filter, Merger; empty for all
+// The index is built on first use or when rebuild is set (after new runs are processed)
+void fetchEvent(int run, Long64_t entry, const std::string& stages = "", bool rebuild = false)
+{
+    std::string dataconf {"../configs/data.conf"};
+    std::string index {"./RootFiles/event_index.root"};
+    EventLocator locator {"../"};
+    if(rebuild || gSystem->AccessPathName(("../" + index).c_str()))
+    {
+        ActRoot::DataManager dataman {dataconf, ActRoot::ModeType::EMerge};
+        locator.Build(dataconf, ChainUtils::GetRuns(dataman.GetChain().get()));
+        locator.Write(index);
+    }
+    else
+        locator.Read(index);
+
+    std::vector<std::string> list;
+    auto* tokens {TString(stages).Tokenize(",")};
+    for(auto* obj : *tokens)
+        list.push_back(TString(obj->GetName()).Strip(TString::kBoth).Data());
+    delete tokens;
+    locator.Print(run, entry, list);
+}
@@ -4,12 +4,18 @@
 #include "ActSilData.h"
 #include "ActTypes.h"
 
+#include "ROOT/RDF/HistoModels.hxx"
 #include "ROOT/RDataFrame.hxx"
 
 #include "TCanvas.h"
+#include "TH1D.h"
 
+#include <cstdint>
 #include <fstream>
 
+#include "../PostAnalysis/EventList.h"
+#include "../PostAnalysis/ZoneMaps.h"
+
 void gateOnGatconf()
 {
     ActRoot::DataManager dataman {"../configs/data.conf", ActRoot::ModeType::EReadSilMod};
@@ -22,18 +28,20 @@ void gateOnGatconf()
     auto df {d.Define("GATCONF", [](ActRoot::ModularData& mod) { return mod.Get("GATCONF"); }, {"ModularData"})};
 
     auto dfFilter {df.Filter(
-        [](float gatconf, ActRoot::MergerData& mer)
+        [](float gatconf, int lightIdx)
         {
-            if(gatconf == 8 && mer.fLightIdx != -1)
+            if(gatconf == 8 && lightIdx != -1)
             {
                 return true;
             }
             return false;
         },
-        {"GATCONF", "MergerData"})};
+        {"GATCONF", "fLightIdx"})};
 
     // Book histogram
-    auto hgat {df.Histo1D({"hgat", "GATCONF;GATCONF", 600, 0, 600}, "GATCONF")};
+    ROOT::RDF::TH1DModel mGat {"hgat", "GATCONF;GATCONF", 600, 0, 600};
+    // Flags of runZoneMaps.cxx hold GATCONF and the light flag: no need to read the chains
+    ZoneMaps::Index index {"../RootFiles/ZoneMaps/", dataman};
     // auto dfE {dfFilter.Filter(
     //     [](ActRoot::SilData& sil, ActRoot::MergerData& mer)
     //     {
@@ -48,10 +56,33 @@ void gateOnGatconf()
     //     },
     //     {"SilData", "MergerData"})};
 
-    // Stream entry number
+    // Stream entry number: binary list for macros and text for DataManager's Manual
+    EventList list;
     std::ofstream streamer {"./Outputs/gatconf_l1.dat"};
-    dfFilter.Foreach([&](ActRoot::MergerData& mer) { mer.Stream(streamer); }, {"MergerData"});
+    TH1D* hgat {};
+    if(index.IsComplete())
+    {
+        hgat = static_cast<TH1D*>(mGat.GetHistogram()->Clone());
+        index.Foreach([&](int, std::int64_t, std::uint32_t flags) { hgat->Fill(flags & ZoneMaps::kGatconfMask); });
+        list = index.Select([](std::uint32_t flags)
+                            { return ZoneMaps::HasGatconf(flags, 8) && (flags & ZoneMaps::kHasLight); });
+        for(const auto& [run, entry] : list.GetEvents())
+            EventList::Stream(streamer, run, entry);
+    }
+    else
+    {
+        auto h {df.Histo1D(mGat, "GATCONF")};
+        dfFilter.Foreach(
+            [&](int run, int entry)
+            {
+                list.Add(run, entry);
+                EventList::Stream(streamer, run, entry);
+            },
+            {"fRun", "fEntry"});
+        hgat = static_cast<TH1D*>(h->Clone());
+    }
     streamer.close();
+    list.Write("./Outputs/gatconf_l1.evl");
     // std::ofstream streamer1 {"./Outputs/gatconf_f0_true.dat"};
     // dfE.Foreach([&](ActRoot::MergerData& mer) { mer.Stream(streamer1); }, {"MergerData"});
     // streamer1.close();
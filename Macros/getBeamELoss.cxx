@@ -1,6 +1,5 @@
 #include "ActDataManager.h"
 #include "ActMergerData.h"
-#include "ActTPCData.h"
 #include "ActTypes.h"
 
 #include "ROOT/RDataFrame.hxx"
@@ -13,6 +12,9 @@
 #include <stdexcept>
 #include <string>
 
+#include "../PostAnalysis/ChainUtils.h"
+#include "../PostAnalysis/ClusterSummary.h"
+
 void getBeamELoss()
 {
     std::string beam {"20Na"};
@@ -27,27 +29,16 @@ void getBeamELoss()
 
     ActRoot::DataManager dataman {conf, ActRoot::ModeType::EMerge};
     auto chain {dataman.GetChain()};
-    auto chainFilter {dataman.GetChain(ActRoot::ModeType::EFilter)};
-    chain->AddFriend(chainFilter.get());
+    auto chainSummary {ChainUtils::GetSidecar(chain.get(), "../RootFiles/Summary/", "Summary_Run_", "SummaryTree")};
+    chain->AddFriend(chainSummary.get());
 
     ROOT::EnableImplicitMT();
     ROOT::RDataFrame df {*chain};
 
     auto gated {df.Filter("fLightIdx != -1")};
 
-    auto def {gated.Define("ELoss",
-                           [](ActRoot::MergerData& mer, ActRoot::TPCData& tpc)
-                           {
-                               auto& cl {tpc.fClusters[mer.fBeamIdx]};
-                               double eloss {};
-                               for(const auto& v : cl.GetVoxels())
-                               {
-                                   if(v.GetPosition().X() < 8)
-                                       eloss += v.GetCharge();
-                               }
-                               return eloss;
-                           },
-                           {"MergerData", "TPCData"})};
+    auto def {gated.Define("ELoss", [](const ROOT::RVecF& qprofile, int beamIdx)
+                           { return ClusterSummary::GetQBelow(qprofile, beamIdx, 8); }, {"QProfile", "fBeamIdx"})};
 
     auto hELoss {def.Histo1D({"hELoss", "Beam ELoss;#DeltaE_{beam} [MeV]", 4000, 0, 60000}, "ELoss")};
 
@@ -16,12 +16,16 @@
 #include "TString.h"
 
 #include <algorithm>
+#include <cstdint>
 #include <fstream>
 #include <iostream>
 #include <map>
 #include <string>
 
+#include "../PostAnalysis/AnalysisTree.h"
 #include "../PostAnalysis/HistConfig.h"
+#include "../PostAnalysis/IOConfig.h"
+#include "../PostAnalysis/ZoneMaps.h"
 
 struct twoAngles
 {
@@ -35,11 +39,13 @@ void getDataFor2pDecay()
 
     // Read data
     ActRoot::DataManager dataman {dataconf, ActRoot::ModeType::EMerge};
-    auto chain {dataman.GetChain()};
-    auto chain2 {dataman.GetChain(ActRoot::ModeType::EReadSilMod)};
-    chain->AddFriend(chain2.get());
-    auto chain3 {dataman.GetChain(ActRoot::ModeType::EFilter)};
-    chain->AddFriend(chain3.get());
+    // Single analysis tree (runAnalysisTree.cxx) or Merger + Data + Filter friends
+    auto chain {GetAnalysisChain(dataman, "../RootFiles/Analysis/", dataconf)};
+    // Read only 4-cluster events (multiplicity in the event flags of runZoneMaps.cxx); the Filter below applies
+    // the other cuts
+    ZoneMaps::Index index {"../RootFiles/ZoneMaps/", dataman};
+    if(index.IsComplete())
+        index.Select([](std::uint32_t flags) { return ZoneMaps::GetNClusters(flags) == 4; }).Apply(chain.fChain.get());
 
     // RDataFrame
     ROOT::EnableImplicitMT();
@@ -156,5 +162,6 @@ void getDataFor2pDecay()
 
     std::string outfile {"./Outputs/tree_ex_20Na_p_2p.root"};
     // Save the tree with angles and epsilon
-    df_angles.Snapshot("Final_Tree", outfile, {"MergerData", "EBeam", "ECM", "RPx", "threeAngles"});
+    IOConfig::Snapshot(df_angles, "getDataFor2pDecay", "Final_Tree", outfile,
+                       {"MergerData", "EBeam", "ECM", "RPx", "threeAngles"});
 }
@@ -19,7 +19,9 @@
 #include <map>
 #include <string>
 
+#include "../PostAnalysis/AnalysisTree.h"
 #include "../PostAnalysis/HistConfig.h"
+#include "../PostAnalysis/IOConfig.h"
 
 struct threeAngles
 {
@@ -34,11 +36,8 @@ void getDataFor3pDecay()
 
     // Read data
     ActRoot::DataManager dataman {dataconf, ActRoot::ModeType::EMerge};
-    auto chain {dataman.GetChain()};
-    auto chain2 {dataman.GetChain(ActRoot::ModeType::EReadSilMod)};
-    chain->AddFriend(chain2.get());
-    auto chain3 {dataman.GetChain(ActRoot::ModeType::EFilter)};
-    chain->AddFriend(chain3.get());
+    // Single analysis tree (runAnalysisTree.cxx) or Merger + Data + Filter friends
+    auto chain {GetAnalysisChain(dataman, "../RootFiles/Analysis/", dataconf)};
 
     // RDataFrame
     ROOT::EnableImplicitMT();
@@ -175,6 +174,6 @@ void getDataFor3pDecay()
 
     std::string outfile {"./Outputs/tree_ex_20Mg_p_3p.root"};
     // Save the tree with angles and epsilon
-    df_angles.Snapshot("Final_Tree", outfile);
+    IOConfig::Snapshot(df_angles, "getDataFor3pDecay", "Final_Tree", outfile);
 
 }
\ No newline at end of file
@@ -19,6 +19,7 @@
 #include <map>
 #include <string>
 
+#include "../PostAnalysis/EventList.h"
 #include "../PostAnalysis/HistConfig.h"
 
 struct twoAngles
@@ -42,7 +43,7 @@ void lookFor2pDecay()
 
 
     std::ofstream streamer {"./Outputs/debug_2p_decay.dat"};
-    df_angles.Foreach([&](ActRoot::MergerData& d) { d.Stream(streamer); }, {"MergerData"});
+    df_angles.Foreach([&](int run, int entry) { EventList::Stream(streamer, run, entry); }, {"fRun", "fEntry"});
     streamer.close();
 
     // Draw them
@@ -0,0 +1,71 @@
+#include "ActCluster.h"
+#include "ActDataManager.h"
+#include "ActInputParser.h"
+#include "ActTPCData.h"
+#include "ActTypes.h"
+
+#include "ROOT/RDataFrame.hxx"
+
+#include "TCanvas.h"
+#include "TH1.h"
+
+#include <iostream>
+#include <string>
+
+#include "../PostAnalysis/ChainUtils.h"
+#include "../configs/user/PileUpCut.h"
+
+void pileUpRates(const std::string& actionconf = "../configs/multiaction.conf")
+{
+    // Pile-up is evaluated with the TagPileUp cut on the Cluster stage, which is the input of that action
+    // (first in the filter). Counts do not depend on DropEvent nor on later actions (BreakChi2, Merge, FindRP...)
+    // that may rebuild clusters and lose the IsPileUp flag
+    ActRoot::InputParser parser {actionconf};
+    ActAlgorithm::PileUpCut cut;
+    cut.Read(parser.GetBlock("TagPileUp"));
+
+    ActRoot::DataManager dataman {"../configs/data.conf", ActRoot::ModeType::EReadTPC};
+    auto chain {dataman.GetChain()};
+
+    ROOT::EnableImplicitMT();
+    ROOT::RDataFrame df {*chain};
+
+    auto def {df.DefinePerSample("Run", [](unsigned int, const ROOT::RDF::RSampleInfo& id)
+                                 { return ChainUtils::GetRun(id.AsString()); })
+                  .Define("IsPileUp", [&cut](ActRoot::TPCData& tpc) { return cut.IsPileUp(tpc.fClusters); },
+                          {"TPCData"})};
+
+    // Counts per run
+    ROOT::RDF::TH1DModel mRun {"hRun", "Pile-up per run;Run;Counts", 200, 0, 200};
+    auto hAll {def.Histo1D(mRun, "Run")};
+    auto hPileUp {def.Filter("IsPileUp").Histo1D(mRun, "Run")};
+
+    // Rate
+    auto* hRate {(TH1D*)hPileUp->Clone("hRate")};
+    hRate->SetTitle("Pile-up rate;Run;Pile-up / events");
+    hRate->Divide(hAll.GetPtr());
+
+    // Print report
+    std::cout << "===== Pile-up report =====" << '\n';
+    for(int b = 1; b <= hAll->GetNbinsX(); b++)
+    {
+        auto all {hAll->GetBinContent(b)};
+        if(all == 0)
+            continue;
+        auto pu {hPileUp->GetBinContent(b)};
+        std::cout << "-> Run " << (int)hAll->GetBinLowEdge(b) << " : " << pu << " / " << all << " = "
+                  << pu / all * 100 << " %" << '\n';
+    }
+    std::cout << "-> Total : " << hPileUp->GetEntries() / hAll->GetEntries() * 100 << " %" << '\n';
+    std::cout << "==========================" << '\n';
+
+    // Draw
+    auto* c0 {new TCanvas {"c0", "Pile-up rates"}};
+    c0->DivideSquare(2);
+    c0->cd(1);
+    hAll->DrawClone();
+    hPileUp->SetLineColor(46);
+    hPileUp->DrawClone("same");
+    c0->cd(2);
+    hRate->Draw("hist");
+}
@@ -1,5 +1,3 @@
-#include "ActMergerData.h"
-#include "ActModularData.h"
 #include "ActSRIM.h"
 
 #include <ROOT/RDataFrame.hxx>
@@ -13,14 +11,17 @@
 #include <map>
 #include <vector>
 
+#include "../PostAnalysis/FlatColumns.h"
+#include "../PostAnalysis/IOConfig.h"
+
 
 void plotECM_intervalsRP()
 {
     // Read data
     auto filename {TString::Format("../PostAnalysis/Outputs/tree_ex_20Mg_p_p.root")};
     ROOT::EnableImplicitMT();
-    ROOT::RDataFrame df {"Final_Tree", filename};
-    auto df_filtered = df.Filter([](ActRoot::MergerData& m) { return m.fLightIdx != -1; }, {"MergerData"});
+    auto df {IOConfig::Read("Final_Tree", filename.Data())};
+    auto df_filtered = df.Filter("LightIdx != -1");
 
     // Get histograms of Ecm on intervals of RP.x()
     std::vector<ROOT::TThreadedObject<TH1D>*> hECMs;
@@ -38,9 +39,8 @@ void plotECM_intervalsRP()
     for(auto& h : hECMs)
         h->GetAtSlot(0)->GetEntries();
     df_filtered.ForeachSlot(
-        [&](unsigned int slot, ActRoot::MergerData& m, double ecm)
+        [&](unsigned int slot, float rp_x, double ecm)
         {
-            auto rp_x {m.fRP.X()};
             // get the hstogram we have to fill
             for(size_t i = 0; i < hECMs.size(); i++)
             {
@@ -51,7 +51,7 @@ void plotECM_intervalsRP()
                 }
             }
         },
-        {"MergerData", "ECM"});
+        {"RPx", "ECM"});
 
     // Plot them all in a canvas
     auto* c {new TCanvas("c", "Ecm intervals canvas")};
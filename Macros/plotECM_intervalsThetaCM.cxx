@@ -1,5 +1,3 @@
-#include "ActMergerData.h"
-
 #include <ROOT/RDataFrame.hxx>
 #include <ROOT/TThreadedObject.hxx>
 
@@ -18,16 +16,18 @@
 
 #include <vector>
 
+#include "../PostAnalysis/FlatColumns.h"
 #include "../PostAnalysis/HistConfig.h"
+#include "../PostAnalysis/IOConfig.h"
 
 void plotECM_intervalsThetaCM()
 {
     // Read data
     auto filename {TString::Format("../PostAnalysis/Outputs/tree_ex_20Na_p_p.root")};
     ROOT::EnableImplicitMT();
-    ROOT::RDataFrame df {"Final_Tree", filename};
-    auto nodeSil {df.Filter([](ActRoot::MergerData& mer) { return !mer.fLight.IsL1(); }, {"MergerData"})};
-    auto nodeL1 {df.Filter([](ActRoot::MergerData& mer) { return mer.fLight.IsL1(); }, {"MergerData"})};
+    auto df {IOConfig::Read("Final_Tree", filename.Data())};
+    auto nodeSil {df.Filter([](unsigned char layer) { return layer != FlatColumns::kL1; }, {"LayerCode"})};
+    auto nodeL1 {df.Filter([](unsigned char layer) { return layer == FlatColumns::kL1; }, {"LayerCode"})};
 
     // Get histograms of Ecm on intervals of RP.x()
     std::vector<ROOT::TThreadedObject<TH1D>*> hsSil, hsL1;
@@ -1,6 +1,5 @@
 #include "ActDataManager.h"
 #include "ActModularData.h"
-#include "ActTPCData.h"
 #include "ActTypes.h"
 
 #include "ROOT/RDF/RInterface.hxx"
@@ -10,12 +9,14 @@
 
 #include <memory>
 
+#include "../PostAnalysis/ChainUtils.h"
+
 void rangeFromCFA()
 {
     ActRoot::DataManager dataman {"../configs/data.conf", ActRoot::ModeType::EReadSilMod};
     auto chain {dataman.GetChain()};
-    auto chainTPC {dataman.GetChain(ActRoot::ModeType::EFilter)};
-    chain->AddFriend(chainTPC.get());
+    auto chainSummary {ChainUtils::GetSidecar(chain.get(), "../RootFiles/Summary/", "Summary_Run_", "SummaryTree")};
+    chain->AddFriend(chainSummary.get());
 
     ROOT::EnableImplicitMT();
     ROOT::RDataFrame df {*chain};
@@ -23,9 +24,8 @@ void rangeFromCFA()
     // Gate on CFAdiv = 64
     // and define beam track length
     auto gated {df.Filter([](ActRoot::ModularData& mod) { return mod.Get("GATCONF") == 64; }, {"ModularData"})
-                    .Filter([](ActRoot::TPCData& tpc) { return tpc.fClusters.size() == 1; }, {"TPCData"})
-                    .Define("LastPad", [](ActRoot::TPCData& tpc)
-                            { return 2 * tpc.fClusters.front().GetXRange().second; }, {"TPCData"})};
+                    .Filter("NClusters == 1")
+                    .Define("LastPad", "2 * XMax[0]")};
 
     auto hLast {gated.Histo1D({"hLast", "Range from CFA;Range [mm]", 100, 0, 250}, "LastPad")};
 
@@ -3,51 +3,43 @@
 #include "ActTypes.h"
 
 #include "ROOT/RDataFrame.hxx"
+#include "ROOT/RVec.hxx"
 
 #include "TCanvas.h"
+#include "TSystem.h"
 
-#include <atomic>
-#include <fstream>
+#include <string>
 
+#include "../PostAnalysis/ChainUtils.h"
+#include "../PostAnalysis/EventList.h"
 #include "../PostAnalysis/HistConfig.h"
+
 void statsRANSAC()
 {
-    // Get data
+    // Read list of selected events; convert text list when it is newer than the binary one
+    EventList list;
+    std::string textfile {"./Outputs/gatconf_f0_true.dat"};
+    std::string listfile {"./Outputs/gatconf_f0_true.evl"};
+    if(ChainUtils::GetModTime(textfile) >= ChainUtils::GetModTime(listfile))
+    {
+        list.ReadText(textfile);
+        list.Write(listfile);
+    }
+    else
+        list.Read(listfile);
+    auto total {list.GetSize()};
+
+    // Get data, reading only the listed entries
     ActRoot::DataManager dataman {"../configs/data.conf", ActRoot::ModeType::EMerge};
     auto chain {dataman.GetChain()};
+    list.Apply(chain.get());
     ROOT::RDataFrame df {*chain};
 
-    // Read file
-    std::map<int, std::set<int>> file;
-    std::ifstream streamer {"./Outputs/gatconf_f0_true.dat"};
-    int run {};
-    int entry {};
-    int total {};
-    while(streamer >> run >> entry)
-    {
-        file[run].insert(entry);
-        total++;
-    }
-
     // Get recovered
-    auto rec {df.Filter(
-        [&](ActRoot::MergerData& d)
-        {
-            if(file.count(d.fRun))
-            {
-                auto& set {file[d.fRun]};
-                if(set.find(d.fEntry) != set.end())
-                {
-                    if(d.fLightIdx != -1)
-                        return true;
-                }
-            }
-            return false;
-        },
-        {"MergerData"})};
+    auto rec {df.Filter("fLightIdx != -1")};
 
     // Plot recovered kinematics
-    auto hKin {rec.Define("y", [](ActRoot::MergerData& d) { return d.fLight.fEs.front(); }, {"MergerData"})
+    auto hKin {rec.Define("y", [](const ROOT::RVecF& es) { return es.front(); }, {"fLight.fEs"})
                    .Histo2D(HistConfig::Kin, "fThetaLight", "y")};
 
     // Plot
@@ -0,0 +1,77 @@
+#ifndef AnalysisTree_h
+#define AnalysisTree_h
+
+#include "ActColors.h"
+#include "ActDataManager.h"
+#include "ActTypes.h"
+
+#include "TChain.h"
+
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "./ChainCatalog.h"
+#include "./ChainUtils.h"
+
+// Chain of the single entry-aligned analysis tree written by runAnalysisTree.cxx
+// Falls back to the Merger chain with Data and Filter friends when any run is missing or older than its
+// Merger, Data or Filter file (stage rerun after runAnalysisTree)
+// The runs are those of dataman; chains are built from the stage catalogs of dataconf (ChainCatalog.h)
+struct AnalysisChain
+{
+    std::shared_ptr<TChain> fChain;
+    std::vector<std::shared_ptr<TChain>> fFriends; //!< Kept alive only in fallback mode
+
+    TChain& operator*() { return *fChain; }
+    TChain* operator->() { return fChain.get(); }
+};
+
+inline AnalysisChain
+GetAnalysisChain(ActRoot::DataManager& dataman, const std::string& dir, const std::string& dataconf)
+{
+    AnalysisChain ret;
+    auto runs {ChainUtils::GetRuns(dataman.GetChain(ActRoot::ModeType::EMerge).get())};
+    auto merger {ChainCatalog::GetUpdatedChain(dataconf, "Merger", runs)};
+    auto data {ChainCatalog::GetUpdatedChain(dataconf, "Data", runs)};
+    auto filter {ChainCatalog::GetUpdatedChain(dataconf, "Filter", runs)};
+    // Newest input per run, over every stage runAnalysisTree reads
+    std::map<int, Long_t> inputs;
+    for(auto* chain : {merger.get(), data.get(), filter.get()})
+        for(const auto& file : ChainUtils::GetFiles(chain))
+        {
+            auto& mtime {inputs[ChainUtils::GetRun(file)]};
+            mtime = std::max(mtime, ChainUtils::GetModTime(file));
+        }
+    std::vector<int> missing, stale;
+    for(auto run : runs)
+    {
+        auto mtime {ChainUtils::GetModTime(ChainUtils::GetFileName(dir, "Analysis_Run_", run))};
+        if(mtime < 0)
+            missing.push_back(run);
+        else if(mtime < inputs[run])
+            stale.push_back(run);
+    }
+    if(missing.empty() && stale.empty())
+    {
+        ret.fChain = ChainUtils::GetSidecar(merger.get(), dir, "Analysis_Run_", "AnalysisTree");
+        return ret;
+    }
+    if(missing.size())
+        std::cout << "GetAnalysisChain(): missing analysis trees in " << dir << ", using friend chains" << '\n';
+    for(auto run : stale)
+        std::cout << BOLDRED << "GetAnalysisChain(): analysis tree of run " << run
+                  << " older than its Merger, Data or Filter file, rerun runAnalysisTree.cxx; using friend chains"
+                  << RESET << '\n';
+    ret.fChain = merger;
+    ret.fFriends.push_back(data);
+    ret.fFriends.push_back(filter);
+    for(auto& f : ret.fFriends)
+        ret.fChain->AddFriend(f.get());
+    return ret;
+}
+
+#endif
@@ -0,0 +1,501 @@
+#ifndef CalibBundle_h
+#define CalibBundle_h
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Versioned binary bundle of the text calibrations (LT, pad alignment, silicons, SRIM tables)
+// written by buildCalibBundle.cxx and opened read-only with mmap, so processes share the page cache
+// Layout: Header, Header::fNSections x Section, then 8-byte aligned payloads
+// Payloads are flat row-major arrays: int32 or float64, or float64 rows prefixed by a 32-char name
+namespace CalibBundle
+{
+constexpr char kMagic[8] {'S', '2', '0', '0', '8', 'C', 'A', 'L'};
+constexpr std::uint32_t kVersion {1};
+constexpr int kNameLength {32};
+
+enum class EType : std::uint32_t
+{
+    kInt32,
+    kFloat64,
+    kNamedFloat64,
+};
+
+struct Header
+{
+    char fMagic[8];
+    std::uint32_t fVersion;
+    std::uint32_t fNSections;
+};
+
+struct Section
+{
+    char fName[64];
+    EType fType;
+    std::uint32_t fNCols;
+    std::uint64_t fNRows;
+    std::uint64_t fOffset;   //!< From the beginning of the file
+    std::uint64_t fSize;     //!< Payload bytes
+    std::uint64_t fChecksum; //!< 64-bit FNV-1a of the payload
+};
+
+inline std::uint64_t Checksum(const void* data, std::uint64_t size)
+{
+    std::uint64_t h {14695981039346656037ull};
+    auto* p {static_cast<const unsigned char*>(data)};
+    for(std::uint64_t i = 0; i < size; i++)
+    {
+        h ^= p[i];
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+// Read-only view of a section
+template <typename T>
+struct Table
+{
+    const T* fData {};
+    std::uint64_t fNRows {};
+    std::uint32_t fNCols {};
+
+    T At(std::uint64_t row, std::uint32_t col) const { return fData[row * fNCols + col]; }
+    const T* Row(std::uint64_t row) const { return fData + row * fNCols; }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Writer: parses the text inputs
+class Writer
+{
+private:
+    struct Entry
+    {
+        Section fSection {};
+        std::vector<char> fPayload;
+    };
+    std::vector<Entry> fEntries;
+
+    static std::vector<std::string> ReadLines(const std::string& file)
+    {
+        std::ifstream streamer {file};
+        if(!streamer)
+            throw std::runtime_error("CalibBundle::Writer: could not open " + file);
+        std::vector<std::string> ret;
+        std::string line;
+        while(std::getline(streamer, line))
+        {
+            // SRIM tables may be written with decimal commas
+            std::replace(line.begin(), line.end(), ',', '.');
+            if(line.find_first_not_of(" \t\r") != std::string::npos)
+                ret.push_back(line);
+        }
+        return ret;
+    }
+
+    template <typename T>
+    void Add(const std::string& name, EType type, std::uint32_t ncols, std::uint64_t nrows, const std::vector<T>& data)
+    {
+        Entry e;
+        if(name.size() >= sizeof(e.fSection.fName))
+            throw std::runtime_error("CalibBundle::Writer: section name too long " + name);
+        std::strncpy(e.fSection.fName, name.c_str(), sizeof(e.fSection.fName) - 1);
+        e.fSection.fType = type;
+        e.fSection.fNCols = ncols;
+        e.fSection.fNRows = nrows;
+        e.fPayload.resize(data.size() * sizeof(T));
+        std::memcpy(e.fPayload.data(), data.data(), e.fPayload.size());
+        fEntries.push_back(std::move(e));
+    }
+
+    static double ToMeV(const std::string& unit)
+    {
+        if(unit == "eV")
+            return 1e-6;
+        if(unit == "keV")
+            return 1e-3;
+        if(unit == "MeV")
+            return 1;
+        if(unit == "GeV")
+            return 1e3;
+        throw std::runtime_error("CalibBundle::Writer: unknown SRIM energy unit " + unit);
+    }
+    static double ToMM(const std::string& unit)
+    {
+        if(unit == "A")
+            return 1e-7;
+        if(unit == "um")
+            return 1e-3;
+        if(unit == "mm")
+            return 1;
+        if(unit == "cm")
+            return 10;
+        if(unit == "m")
+            return 1e3;
+        if(unit == "km")
+            return 1e6;
+        throw std::runtime_error("CalibBundle::Writer: unknown SRIM length unit " + unit);
+    }
+
+    // "MeV / (mg/cm2)  " -> "MeV/(mg/cm2)"
+    static std::string NormalizeUnit(std::string unit)
+    {
+        unit.erase(std::remove_if(unit.begin(), unit.end(), [](unsigned char c) { return std::isspace(c); }),
+                   unit.end());
+        return unit;
+    }
+
+public:
+    // Whitespace separated integer columns (LT.txt)
+    void AddInts(const std::string& name, const std::string& file)
+    {
+        std::vector<std::int32_t> data;
+        std::uint32_t ncols {};
+        std::uint64_t nrows {};
+        for(const auto& line : ReadLines(file))
+        {
+            std::istringstream iss {line};
+            std::vector<std::int32_t> row;
+            std::int32_t v {};
+            while(iss >> v)
+                row.push_back(v);
+            if(nrows == 0)
+                ncols = row.size();
+            else if(row.size() != ncols)
+                throw std::runtime_error("CalibBundle::Writer: irregular row in " + file);
+            data.insert(data.end(), row.begin(), row.end());
+            nrows++;
+        }
+        Add(name, EType::kInt32, ncols, nrows, data);
+    }
+    // Whitespace separated floating point columns (pad alignment)
+    void AddDoubles(const std::string& name, const std::string& file)
+    {
+        std::vector<double> data;
+        std::uint32_t ncols {};
+        std::uint64_t nrows {};
+        for(const auto& line : ReadLines(file))
+        {
+            std::istringstream iss {line};
+            std::vector<double> row;
+            double v {};
+            while(iss >> v)
+                row.push_back(v);
+            if(nrows == 0)
+                ncols = row.size();
+            else if(row.size() != ncols)
+                throw std::runtime_error("CalibBundle::Writer: irregular row in " + file);
+            data.insert(data.end(), row.begin(), row.end());
+            nrows++;
+        }
+        Add(name, EType::kFloat64, ncols, nrows, data);
+    }
+    // Key followed by its parameters (silicon calibrations)
+    void AddNamed(const std::string& name, const std::string& file)
+    {
+        std::vector<char> data;
+        std::uint32_t ncols {};
+        std::uint64_t nrows {};
+        for(const auto& line : ReadLines(file))
+        {
+            std::istringstream iss {line};
+            std::string key;
+            iss >> key;
+            std::vector<double> row;
+            double v {};
+            while(iss >> v)
+                row.push_back(v);
+            if(nrows == 0)
+                ncols = row.size();
+            else if(row.size() != ncols)
+                throw std::runtime_error("CalibBundle::Writer: irregular row in " + file);
+            if(key.size() >= kNameLength)
+                throw std::runtime_error("CalibBundle::Writer: key too long " + key);
+            char buf[kNameLength] {};
+            std::strncpy(buf, key.c_str(), kNameLength - 1);
+            data.insert(data.end(), buf, buf + kNameLength);
+            auto* p {reinterpret_cast<const char*>(row.data())};
+            data.insert(data.end(), p, p + row.size() * sizeof(double));
+            nrows++;
+        }
+        Add(name, EType::kNamedFloat64, ncols, nrows, data);
+    }
+    // SRIM table in common units: E [MeV], dE/dx elec and nuclear [MeV/mm], range, long. and lat. straggling [mm]
+    // Stopping powers are converted with the factors SRIM prints below the table ("Multiply Stopping by X for
+    // Stopping Units U": table x X is in U); without them, only tables written in MeV / mm are accepted
+    // The factors are checked against the Stopping Units line (factor 1) and the Target Density line
+    void AddSRIM(const std::string& name, const std::string& file)
+    {
+        std::vector<double> data;
+        std::uint64_t nrows {};
+        enum
+        {
+            kHeader,
+            kTable,
+            kFactors
+        } state {kHeader};
+        std::string units;
+        double density {}; // g/cm3
+        std::map<std::string, double> factors;
+        for(const auto& line : ReadLines(file))
+        {
+            auto first {line.find_first_not_of(' ')};
+            if(state == kHeader && line.find("Stopping Units =") != std::string::npos)
+            {
+                units = NormalizeUnit(line.substr(line.find('=') + 1));
+                continue;
+            }
+            if(state == kHeader && line.find("Target Density =") != std::string::npos)
+            {
+                std::istringstream iss {line.substr(line.find('=') + 1)};
+                iss >> density;
+                continue;
+            }
+            if(state != kFactors && line.compare(first, 5, "-----") == 0)
+            {
+                // Dashes under the column titles open the table, a long line of dashes closes it
+                state = (state == kHeader) ? kTable : kFactors;
+                continue;
+            }
+            if(state == kFactors)
+            {
+                // Factor to get each unit from the table ones
+                std::istringstream iss {line};
+                double factor {};
+                std::string rest;
+                if(iss >> factor && std::getline(iss, rest))
+                    factors[NormalizeUnit(rest)] = factor;
+                continue;
+            }
+            if(state != kTable)
+                continue;
+            std::istringstream iss {line};
+            double e {}, dedxE {}, dedxN {}, range {}, lon {}, lat {};
+            std::string ue, ur, ul, ut;
+            if(!(iss >> e >> ue >> dedxE >> dedxN >> range >> ur >> lon >> ul >> lat >> ut))
+                throw std::runtime_error("CalibBundle::Writer: bad SRIM line in " + file + ": " + line);
+            for(auto v : {e * ToMeV(ue), dedxE, dedxN, range * ToMM(ur), lon * ToMM(ul), lat * ToMM(ut)})
+                data.push_back(v);
+            nrows++;
+        }
+        double toMeVmm {1};
+        if(factors.count("MeV/mm"))
+        {
+            toMeVmm = factors["MeV/mm"];
+            auto bad {[](double a, double b) { return std::abs(a / b - 1) > 0.01; }};
+            if(factors.count(units) && bad(factors[units], 1))
+                throw std::runtime_error("CalibBundle::Writer: SRIM factor of the table units " + units + " in " +
+                                         file + " is not 1");
+            // Independent conversion from the table units (density for areal units); ex: MeV/(mg/cm2) x
+            // density [mg/cm3] x 0.1 cm/mm
+            std::map<std::string, double> expected {{"MeV/mm", 1},
+                                                    {"keV/micron", 1},
+                                                    {"eV/Angstrom", 10},
+                                                    {"MeV/(mg/cm2)", density * 100},
+                                                    {"keV/(mg/cm2)", density * 0.1},
+                                                    {"keV/(ug/cm2)", density * 100}};
+            if(expected.count(units) && expected[units] > 0 && bad(toMeVmm, expected[units]))
+                throw std::runtime_error("CalibBundle::Writer: SRIM conversion of " + units + " to MeV/mm in " + file +
+                                         " does not match its target density");
+        }
+        else if(units != "MeV/mm")
+            throw std::runtime_error("CalibBundle::Writer: SRIM stopping units '" + units + "' of " + file +
+                                     " cannot be converted to MeV/mm");
+        for(std::uint64_t r = 0; r < nrows; r++)
+        {
+            data[6 * r + 1] *= toMeVmm;
+            data[6 * r + 2] *= toMeVmm;
+        }
+        Add(name, EType::kFloat64, 6, nrows, data);
+    }
+
+    void Write(const std::string& file)
+    {
+        std::uint64_t offset {sizeof(Header) + fEntries.size() * sizeof(Section)};
+        for(auto& e : fEntries)
+        {
+            offset = (offset + 7) & ~std::uint64_t {7};
+            e.fSection.fOffset = offset;
+            e.fSection.fSize = e.fPayload.size();
+            e.fSection.fChecksum = Checksum(e.fPayload.data(), e.fPayload.size());
+            offset += e.fPayload.size();
+        }
+        std::ofstream streamer {file, std::ios::binary};
+        if(!streamer)
+            throw std::runtime_error("CalibBundle::Writer: could not open " + file);
+        Header header {};
+        std::memcpy(header.fMagic, kMagic, sizeof(kMagic));
+        header.fVersion = kVersion;
+        header.fNSections = fEntries.size();
+        streamer.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        for(const auto& e : fEntries)
+            streamer.write(reinterpret_cast<const char*>(&e.fSection), sizeof(Section));
+        for(const auto& e : fEntries)
+        {
+            while(static_cast<std::uint64_t>(streamer.tellp()) < e.fSection.fOffset)
+                streamer.put('\0');
+            streamer.write(e.fPayload.data(), e.fPayload.size());
+        }
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Reader: maps the whole file; views are valid while the Bundle lives
+class Bundle
+{
+private:
+    const char* fData {};
+    std::uint64_t fSize {};
+    std::map<std::string, const Section*> fSections;
+
+    const Section& Find(const std::string& name, EType type) const
+    {
+        auto it {fSections.find(name)};
+        if(it == fSections.end())
+            throw std::runtime_error("CalibBundle::Bundle: no section " + name);
+        if(it->second->fType != type)
+            throw std::runtime_error("CalibBundle::Bundle: wrong type requested for section " + name);
+        return *it->second;
+    }
+
+public:
+    Bundle(const std::string& file, bool verify = true)
+    {
+        auto fd {::open(file.c_str(), O_RDONLY)};
+        if(fd < 0)
+            throw std::runtime_error("CalibBundle::Bundle: could not open " + file);
+        struct stat st {};
+        ::fstat(fd, &st);
+        fSize = st.st_size;
+        auto* ptr {::mmap(nullptr, fSize, PROT_READ, MAP_SHARED, fd, 0)};
+        ::close(fd);
+        if(ptr == MAP_FAILED)
+            throw std::runtime_error("CalibBundle::Bundle: could not mmap " + file);
+        fData = static_cast<const char*>(ptr);
+
+        auto* header {reinterpret_cast<const Header*>(fData)};
+        if(fSize < sizeof(Header) || std::memcmp(header->fMagic, kMagic, sizeof(kMagic)) != 0 ||
+           header->fVersion != kVersion)
+        {
+            ::munmap(const_cast<char*>(fData), fSize);
+            throw std::runtime_error("CalibBundle::Bundle: " + file + " is not a version " +
+                                     std::to_string(kVersion) + " calibration bundle");
+        }
+        auto* sections {reinterpret_cast<const Section*>(fData + sizeof(Header))};
+        for(std::uint32_t i = 0; i < header->fNSections; i++)
+        {
+            const auto& s {sections[i]};
+            if(s.fOffset + s.fSize > fSize || (verify && Checksum(fData + s.fOffset, s.fSize) != s.fChecksum))
+            {
+                ::munmap(const_cast<char*>(fData), fSize);
+                throw std::runtime_error("CalibBundle::Bundle: corrupted section " + std::string {s.fName} + " in " +
+                                         file);
+            }
+            fSections[s.fName] = &s;
+        }
+    }
+    ~Bundle()
+    {
+        if(fData)
+            ::munmap(const_cast<char*>(fData), fSize);
+    }
+    Bundle(const Bundle&) = delete;
+    Bundle& operator=(const Bundle&) = delete;
+
+    bool Has(const std::string& name) const { return fSections.count(name); }
+    std::vector<std::string> GetSectionNames() const
+    {
+        std::vector<std::string> ret;
+        for(const auto& [name, _] : fSections)
+            ret.push_back(name);
+        return ret;
+    }
+
+    Table<std::int32_t> GetInts(const std::string& name) const
+    {
+        const auto& s {Find(name, EType::kInt32)};
+        return {reinterpret_cast<const std::int32_t*>(fData + s.fOffset), s.fNRows, s.fNCols};
+    }
+    Table<double> GetDoubles(const std::string& name) const
+    {
+        const auto& s {Find(name, EType::kFloat64)};
+        return {reinterpret_cast<const double*>(fData + s.fOffset), s.fNRows, s.fNCols};
+    }
+    // Copies the (small) named sections into a map key -> parameters
+    std::map<std::string, std::vector<double>> GetNamed(const std::string& name) const
+    {
+        const auto& s {Find(name, EType::kNamedFloat64)};
+        std::map<std::string, std::vector<double>> ret;
+        auto rowSize {kNameLength + s.fNCols * sizeof(double)};
+        for(std::uint64_t r = 0; r < s.fNRows; r++)
+        {
+            auto* row {fData + s.fOffset + r * rowSize};
+            auto* pars {reinterpret_cast<const double*>(row + kNameLength)};
+            ret[std::string {row}] = std::vector<double>(pars, pars + s.fNCols);
+        }
+        return ret;
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Lookups on a SRIM section, with the interface of ActPhysics::SRIM for a single table
+// Linear interpolation in the tabulated points; keeps a view, so the Bundle must outlive it
+class SRIMTable
+{
+private:
+    Table<double> fTable;
+
+    // Interpolate column ycol at x of column xcol (increasing in both); below the first point, towards (0, 0)
+    double Interpolate(std::uint32_t xcol, std::uint32_t ycol, double x) const
+    {
+        std::uint64_t lo {0}, hi {fTable.fNRows - 1};
+        if(x <= fTable.At(lo, xcol))
+            return fTable.At(lo, ycol) * x / fTable.At(lo, xcol);
+        if(x >= fTable.At(hi, xcol))
+            return fTable.At(hi, ycol);
+        while(hi - lo > 1)
+        {
+            auto mid {(lo + hi) / 2};
+            (fTable.At(mid, xcol) <= x ? lo : hi) = mid;
+        }
+        auto t {(x - fTable.At(lo, xcol)) / (fTable.At(hi, xcol) - fTable.At(lo, xcol))};
+        return fTable.At(lo, ycol) + t * (fTable.At(hi, ycol) - fTable.At(lo, ycol));
+    }
+
+public:
+    SRIMTable(const Bundle& bundle, const std::string& name) : fTable(bundle.GetDoubles(name))
+    {
+        if(fTable.fNCols != 6 || fTable.fNRows < 2)
+            throw std::runtime_error("CalibBundle::SRIMTable: " + name + " is not a SRIM table");
+    }
+
+    // Range [mm] of energy [MeV] and its inverse
+    double EvalRange(double e) const { return Interpolate(0, 3, e); }
+    double EvalEnergy(double range) const { return Interpolate(3, 0, range); }
+    // Total stopping power [MeV/mm]
+    double EvalStoppingPower(double e) const { return Interpolate(0, 1, e) + Interpolate(0, 2, e); }
+    // Energy after crossing dist [mm] from energy e [MeV], 0 if it stops
+    double Slow(double e, double dist) const
+    {
+        auto range {EvalRange(e) - dist};
+        return range > 0 ? EvalEnergy(range) : 0;
+    }
+    // Initial energy to have e [MeV] after dist [mm]
+    double EvalInitialEnergy(double e, double dist) const { return EvalEnergy(EvalRange(e) + dist); }
+};
+} // namespace CalibBundle
+
+#endif
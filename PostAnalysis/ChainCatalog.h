@@ -0,0 +1,223 @@
+#ifndef ChainCatalog_h
+#define ChainCatalog_h
+
+#include "ActInputParser.h"
+
+#include "TBranch.h"
+#include "TChain.h"
+#include "TFile.h"
+#include "TString.h"
+#include "TSystem.h"
+#include "TTree.h"
+
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "./ChainUtils.h"
+
+// Cached metadata of the run files of one data.conf stage, in <Path>/catalog.dat:
+// run, size, mtime, entries, tree name and a checksum of the branch list, one line per file
+// Chains are built with TChain::Add(file, entries), so no file is opened before the event loop;
+// only files whose size or mtime changed are reopened when updating
+class ChainCatalog
+{
+public:
+    struct Entry
+    {
+        int fRun {};
+        Long64_t fSize {};
+        Long_t fMTime {};
+        Long64_t fEntries {};
+        std::string fTree;
+        std::uint64_t fBranchHash {};
+        std::string fFile;
+    };
+
+private:
+    std::string fStage;
+    std::string fTree;
+    std::string fPath;
+    std::string fBegin;
+    std::string fEnd;
+    std::string fPrefix;
+    std::map<int, Entry> fEntries;
+
+    std::string GetCatalogFile() const { return fPrefix + fPath + "catalog.dat"; }
+
+    static std::uint64_t HashBranches(TTree* tree)
+    {
+        std::uint64_t h {14695981039346656037ull};
+        for(auto* obj : *tree->GetListOfBranches())
+        {
+            auto* br {static_cast<TBranch*>(obj)};
+            std::string str {std::string {br->GetName()} + ":" + br->GetClassName() + ";"};
+            for(unsigned char c : str)
+            {
+                h ^= c;
+                h *= 1099511628211ull;
+            }
+        }
+        return h;
+    }
+
+public:
+    // prefix: where the Paths of dataconf are relative to; by default the parent of its directory
+    ChainCatalog(const std::string& dataconf, const std::string& stage, const std::string& prefix = "")
+        : fStage(stage),
+          fPrefix(prefix.size() ? prefix : std::string {gSystem->GetDirName(dataconf.c_str()).Data()} + "/../")
+    {
+        ActRoot::InputParser parser {dataconf};
+        auto block {parser.GetBlock(stage)};
+        fTree = block->GetString("TreeName");
+        fPath = block->GetString("Path");
+        fBegin = block->GetString("Begin");
+        if(block->CheckTokenExists("End"))
+            fEnd = block->GetString("End");
+        Read();
+    }
+
+    void Read()
+    {
+        fEntries.clear();
+        std::ifstream streamer {GetCatalogFile()};
+        std::string line;
+        while(std::getline(streamer, line))
+        {
+            std::istringstream iss {line};
+            Entry e;
+            if(iss >> e.fRun >> e.fSize >> e.fMTime >> e.fEntries >> e.fTree >> e.fBranchHash >> e.fFile)
+                fEntries[e.fRun] = e;
+        }
+    }
+
+    void Write() const
+    {
+        std::ofstream streamer {GetCatalogFile()};
+        for(const auto& [run, e] : fEntries)
+            streamer << e.fRun << " " << e.fSize << " " << e.fMTime << " " << e.fEntries << " " << e.fTree << " "
+                     << e.fBranchHash << " " << e.fFile << '\n';
+    }
+
+    // Stat the files of runs and reopen only the new or modified ones; returns the number reopened
+    int Update(const std::vector<int>& runs)
+    {
+        int ret {};
+        for(auto run : runs)
+        {
+            auto file {ChainUtils::GetFileName(fPath, fBegin, run, fEnd)};
+            FileStat_t stat;
+            if(gSystem->GetPathInfo((fPrefix + file).c_str(), stat) != 0)
+            {
+                fEntries.erase(run);
+                continue;
+            }
+            auto it {fEntries.find(run)};
+            if(it != fEntries.end() && it->second.fSize == stat.fSize && it->second.fMTime == stat.fMtime)
+                continue;
+            Entry e {run, stat.fSize, stat.fMtime, -1, fTree, 0, file};
+            auto f {std::unique_ptr<TFile>(TFile::Open((fPrefix + file).c_str()))};
+            if(f && !f->IsZombie())
+                if(auto* tree {f->Get<TTree>(fTree.c_str())}; tree)
+                {
+                    e.fEntries = tree->GetEntries();
+                    e.fBranchHash = HashBranches(tree);
+                }
+            fEntries[run] = e;
+            ret++;
+        }
+        Write();
+        return ret;
+    }
+
+    // Chain of runs from the cached entry counts, without opening any file
+    std::shared_ptr<TChain> GetChain(const std::vector<int>& runs) const
+    {
+        auto ret {std::make_shared<TChain>(fTree.c_str())};
+        for(auto run : runs)
+        {
+            auto it {fEntries.find(run)};
+            if(it == fEntries.end() || it->second.fEntries < 0)
+                ret->Add((fPrefix + ChainUtils::GetFileName(fPath, fBegin, run, fEnd)).c_str());
+            else
+                ret->Add((fPrefix + it->second.fFile).c_str(), it->second.fEntries);
+        }
+        return ret;
+    }
+
+    const Entry* GetEntry(int run) const
+    {
+        auto it {fEntries.find(run)};
+        return it == fEntries.end() ? nullptr : &it->second;
+    }
+
+    // Report missing, unreadable and stale files and branch lists differing from the first run
+    // Uses only the catalog and a stat per file; returns true if all runs are consistent
+    bool Validate(const std::vector<int>& runs, const std::map<int, Long64_t>& reference = {}) const
+    {
+        bool ret {true};
+        const Entry* first {};
+        for(auto run : runs)
+        {
+            auto* e {GetEntry(run)};
+            FileStat_t stat;
+            if(!e || gSystem->GetPathInfo((fPrefix + e->fFile).c_str(), stat) != 0)
+            {
+                std::cout << fStage << " run " << run << ": missing file" << '\n';
+                ret = false;
+                continue;
+            }
+            if(e->fEntries < 0)
+            {
+                std::cout << fStage << " run " << run << ": no " << fTree << " in " << e->fFile << '\n';
+                ret = false;
+                continue;
+            }
+            if(stat.fSize != e->fSize || stat.fMtime != e->fMTime)
+            {
+                // Cached entries and branches no longer describe the file
+                std::cout << fStage << " run " << run << ": modified since cataloged, run Update()" << '\n';
+                ret = false;
+                continue;
+            }
+            if(!first)
+                first = e;
+            else if(e->fBranchHash != first->fBranchHash)
+            {
+                std::cout << fStage << " run " << run << ": branches differ from run " << first->fRun << '\n';
+                ret = false;
+            }
+            if(reference.count(run) && reference.at(run) != e->fEntries)
+            {
+                std::cout << fStage << " run " << run << ": " << e->fEntries << " entries but " << reference.at(run)
+                          << " in reference stage" << '\n';
+                ret = false;
+            }
+        }
+        return ret;
+    }
+
+    // Catalog of stage brought up to date for runs and its chain, as used by the pipes
+    static std::shared_ptr<TChain>
+    GetUpdatedChain(const std::string& dataconf, const std::string& stage, const std::vector<int>& runs)
+    {
+        ChainCatalog catalog {dataconf, stage};
+        catalog.Update(runs);
+        return catalog.GetChain(runs);
+    }
+
+    std::map<int, Long64_t> GetEntriesPerRun() const
+    {
+        std::map<int, Long64_t> ret;
+        for(const auto& [run, e] : fEntries)
+            ret[run] = e.fEntries;
+        return ret;
+    }
+};
+
+#endif
@@ -0,0 +1,82 @@
+#ifndef ChainUtils_h
+#define ChainUtils_h
+
+#include "TChain.h"
+#include "TChainElement.h"
+#include "TCollection.h"
+#include "TFriendElement.h"
+#include "TString.h"
+#include "TSystem.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+// Helpers to build chains of files written alongside the ActRoot ones (same runs, same entries)
+namespace ChainUtils
+{
+// Files in chain, in order
+inline std::vector<std::string> GetFiles(TChain* chain)
+{
+    std::vector<std::string> ret;
+    for(auto* el : *chain->GetListOfFiles())
+        ret.push_back(static_cast<TChainElement*>(el)->GetTitle());
+    return ret;
+}
+
+// Files in chain and in its friend chains
+inline std::vector<std::string> GetFilesWithFriends(TChain* chain)
+{
+    auto ret {GetFiles(chain)};
+    if(auto* friends {chain->GetListOfFriends()}; friends)
+        for(auto* obj : *friends)
+            if(auto* fr {dynamic_cast<TChain*>(static_cast<TFriendElement*>(obj)->GetTree())}; fr)
+                for(const auto& file : GetFiles(fr))
+                    ret.push_back(file);
+    return ret;
+}
+
+// Run number from ActRoot file name (.../Begin_Run_XXXX[End].root)
+inline int GetRun(const std::string& file)
+{
+    auto pos {file.rfind("_Run_")};
+    if(pos == std::string::npos)
+        return -1;
+    return std::stoi(file.substr(pos + 5));
+}
+
+inline std::vector<int> GetRuns(TChain* chain)
+{
+    std::vector<int> ret;
+    for(const auto& file : GetFiles(chain))
+        ret.push_back(GetRun(file));
+    return ret;
+}
+
+// File name of run in dir
+inline std::string GetFileName(const std::string& dir, const std::string& begin, int run, const std::string& end = "")
+{
+    return TString::Format("%s%s%04d%s.root", dir.c_str(), begin.c_str(), run, end.c_str()).Data();
+}
+
+// Modification time of file, -1 if it does not exist
+inline Long_t GetModTime(const std::string& file)
+{
+    FileStat_t stat;
+    if(gSystem->GetPathInfo(file.c_str(), stat) != 0)
+        return -1;
+    return stat.fMtime;
+}
+
+// Chain with the same runs as ref read from dir/beginXXXX.root
+inline std::shared_ptr<TChain>
+GetSidecar(TChain* ref, const std::string& dir, const std::string& begin, const std::string& tree)
+{
+    auto ret {std::make_shared<TChain>(tree.c_str())};
+    for(auto run : GetRuns(ref))
+        ret->Add(GetFileName(dir, begin, run).c_str());
+    return ret;
+}
+} // namespace ChainUtils
+
+#endif
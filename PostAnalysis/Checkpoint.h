@@ -0,0 +1,173 @@
+#ifndef Checkpoint_h
+#define Checkpoint_h
+
+#include "Compression.h"
+#include "TFile.h"
+#include "TFileMerger.h"
+#include "TH1.h"
+#include "TKey.h"
+#include "TString.h"
+#include "TSystem.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "./ChainUtils.h"
+#include "./DerivedCache.h"
+#include "./IOConfig.h"
+
+// Resumable run-by-run processing of a pipe, stored in <dir><name>_<key>.root:
+// the histograms accumulated over the finished runs, the list of finished runs and the snapshot of each
+// finished run as a part file (<dir><name>_<key>_Run_XXXX.root), merged in run order by Merge()
+// The key is that of DerivedCache (content of the dependency files) plus the size and mtime of the input
+// files of every run, so a checkpoint is only resumed by the same job on the same data; Commit() writes it
+// atomically after each run, so an interrupted job loses at most one run
+class Checkpoint
+{
+private:
+    std::string fName;
+    std::string fDir;
+    std::string fKey;
+    std::vector<int> fRuns;
+    std::vector<int> fDone;
+    std::map<std::string, std::unique_ptr<TH1>> fHistos;
+
+public:
+    // deps: sources, headers, configs and cuts, hashed by content; inputs: data files of the runs (ex:
+    // ChainUtils::GetFilesWithFriends), hashed by size and mtime
+    Checkpoint(const std::string& name, const std::vector<int>& runs, const std::vector<std::string>& deps,
+               const std::vector<std::string>& inputs, const std::string& dir = "./Outputs/Checkpoints/")
+        : fName(name),
+          fDir(dir),
+          fRuns(runs)
+    {
+        gSystem->mkdir(fDir.c_str(), true);
+        // Missing dependencies (ex: cuts not drawn yet) are part of the job definition too
+        std::vector<std::string> existing;
+        for(const auto& dep : deps)
+            if(!gSystem->AccessPathName(dep.c_str()))
+                existing.push_back(dep);
+        std::uint64_t h {std::stoull(DerivedCache {fName, fDir, existing}.GetKey(), nullptr, 16)};
+        for(const auto& input : inputs)
+        {
+            FileStat_t stat;
+            auto exists {gSystem->GetPathInfo(input.c_str(), stat) == 0};
+            DerivedCache::Hash(h, TString::Format("%s %lld %ld;", input.c_str(), exists ? stat.fSize : -1LL,
+                                                  exists ? stat.fMtime : -1L)
+                                      .Data());
+        }
+        fKey = TString::Format("%016llx", static_cast<unsigned long long>(h)).Data();
+        Read();
+    }
+
+    std::string GetFile() const { return fDir + fName + "_" + fKey + ".root"; }
+    std::string GetPartFile(int run) const { return ChainUtils::GetFileName(fDir, fName + "_" + fKey + "_Run_", run); }
+
+    // Runs still to be processed, in the original order
+    std::vector<int> GetPending() const
+    {
+        std::vector<int> ret;
+        for(auto run : fRuns)
+            if(std::find(fDone.begin(), fDone.end(), run) == fDone.end())
+                ret.push_back(run);
+        return ret;
+    }
+
+    // Accumulate the result of the current run
+    void Add(const std::string& key, const TH1& h)
+    {
+        auto& stored {fHistos[key]};
+        if(!stored)
+        {
+            stored.reset(static_cast<TH1*>(h.Clone(key.c_str())));
+            stored->SetDirectory(nullptr);
+        }
+        else
+            stored->Add(&h);
+    }
+
+    // Accumulated histogram over the finished runs (nullptr if never added)
+    TH1* Get(const std::string& key) const
+    {
+        auto it {fHistos.find(key)};
+        return it == fHistos.end() ? nullptr : it->second.get();
+    }
+
+    // Mark run as finished (its part file already written) and save the checkpoint
+    void Commit(int run)
+    {
+        fDone.push_back(run);
+        auto tmp {GetFile() + ".tmp"};
+        {
+            auto f {std::make_unique<TFile>(tmp.c_str(), "recreate")};
+            f->WriteObject(&fDone, "Done");
+            for(const auto& [key, h] : fHistos)
+                h->Write(key.c_str());
+            f->Close();
+        }
+        gSystem->Rename(tmp.c_str(), GetFile().c_str());
+    }
+
+    // Merge the part files of all runs in run order into outfile; returns false if any is missing
+    bool Merge(const std::string& outfile) const
+    {
+        TFileMerger merger {false};
+        merger.SetPrintLevel(0);
+        // Same compression as the parts, so baskets are copied without recompressing
+        auto opts {IOConfig::GetSnapshotOptions()};
+        merger.OutputFile(outfile.c_str(), "recreate",
+                          ROOT::CompressionSettings(opts.fCompressionAlgorithm, opts.fCompressionLevel));
+        for(auto run : fRuns)
+        {
+            auto part {GetPartFile(run)};
+            if(gSystem->AccessPathName(part.c_str()))
+            {
+                std::cout << "Checkpoint::Merge(): missing " << part << ", " << outfile << " not written" << '\n';
+                return false;
+            }
+            merger.AddFile(part.c_str(), false);
+        }
+        return merger.Merge();
+    }
+
+    // Job completed: remove the checkpoint and its part files
+    void Clear() const
+    {
+        for(auto run : fRuns)
+            gSystem->Unlink(GetPartFile(run).c_str());
+        gSystem->Unlink(GetFile().c_str());
+    }
+
+private:
+    void Read()
+    {
+        if(gSystem->AccessPathName(GetFile().c_str()))
+            return;
+        auto f {std::unique_ptr<TFile>(TFile::Open(GetFile().c_str()))};
+        if(!f || f->IsZombie())
+            return;
+        if(auto* done {f->Get<std::vector<int>>("Done")}; done)
+        {
+            fDone = *done;
+            delete done;
+        }
+        for(auto* obj : *f->GetListOfKeys())
+        {
+            auto* key {static_cast<TKey*>(obj)};
+            if(!TString {key->GetClassName()}.BeginsWith("TH"))
+                continue;
+            auto* h {key->ReadObject<TH1>()};
+            h->SetDirectory(nullptr);
+            fHistos[key->GetName()].reset(h);
+        }
+        std::cout << "Checkpoint: resuming " << fName << " after " << fDone.size() << " of " << fRuns.size()
+                  << " runs" << '\n';
+    }
+};
+
+#endif
@@ -0,0 +1,128 @@
+#ifndef ClusterSummary_h
+#define ClusterSummary_h
+
+#include "ActCluster.h"
+#include "ActTPCData.h"
+
+#include "TTree.h"
+
+#include <algorithm>
+#include <vector>
+
+// Per-cluster summary of the Filter output, written by runClusterSummary.cxx
+// to RootFiles/Summary/Summary_Run_XXXX.root (SummaryTree, entry-aligned with Filter);
+// runClusterSummary.cxx(dataconf, "Cluster") writes that of the Cluster stage to SummaryCluster_Run_XXXX.root
+// Each branch is a vector with one element per cluster, except QProfile, that holds
+// kNPads elements per cluster: charge in pads X = 0, ..., kNPads - 1
+namespace ClusterSummary
+{
+constexpr int kNPads {16};
+
+enum Flags
+{
+    kBeamLike = 1 << 0,
+    kRANSAC = 1 << 1,
+    kPileUp = 1 << 2,
+};
+
+struct Data
+{
+    int fNClusters {};
+    std::vector<float> fPx, fPy, fPz; //!< Line point
+    std::vector<float> fDx, fDy, fDz; //!< Line direction
+    std::vector<float> fChi2;
+    std::vector<float> fXMin, fXMax, fYMin, fYMax, fZMin, fZMax;
+    std::vector<float> fQ;
+    std::vector<float> fQProfile;
+    std::vector<int> fNVoxels;
+    std::vector<int> fFlags;
+
+    void SetBranches(TTree* tree)
+    {
+        tree->Branch("NClusters", &fNClusters);
+        tree->Branch("Px", &fPx);
+        tree->Branch("Py", &fPy);
+        tree->Branch("Pz", &fPz);
+        tree->Branch("Dx", &fDx);
+        tree->Branch("Dy", &fDy);
+        tree->Branch("Dz", &fDz);
+        tree->Branch("Chi2", &fChi2);
+        tree->Branch("XMin", &fXMin);
+        tree->Branch("XMax", &fXMax);
+        tree->Branch("YMin", &fYMin);
+        tree->Branch("YMax", &fYMax);
+        tree->Branch("ZMin", &fZMin);
+        tree->Branch("ZMax", &fZMax);
+        tree->Branch("Q", &fQ);
+        tree->Branch("QProfile", &fQProfile);
+        tree->Branch("NVoxels", &fNVoxels);
+        tree->Branch("Flags", &fFlags);
+    }
+
+    void Fill(const ActRoot::TPCData& tpc)
+    {
+        for(auto* v : {&fPx, &fPy, &fPz, &fDx, &fDy, &fDz, &fChi2, &fXMin, &fXMax, &fYMin, &fYMax, &fZMin, &fZMax,
+                       &fQ, &fQProfile})
+            v->clear();
+        fNVoxels.clear();
+        fFlags.clear();
+        fNClusters = tpc.fClusters.size();
+        for(const auto& cl : tpc.fClusters)
+        {
+            const auto& line {cl.GetLine()};
+            auto p {line.GetPoint()};
+            auto d {line.GetDirection()};
+            fPx.push_back(p.X());
+            fPy.push_back(p.Y());
+            fPz.push_back(p.Z());
+            fDx.push_back(d.X());
+            fDy.push_back(d.Y());
+            fDz.push_back(d.Z());
+            fChi2.push_back(line.GetChi2());
+            auto [xmin, xmax] {cl.GetXRange()};
+            auto [ymin, ymax] {cl.GetYRange()};
+            auto [zmin, zmax] {cl.GetZRange()};
+            fXMin.push_back(xmin);
+            fXMax.push_back(xmax);
+            fYMin.push_back(ymin);
+            fYMax.push_back(ymax);
+            fZMin.push_back(zmin);
+            fZMax.push_back(zmax);
+            // Charge
+            float q {};
+            auto offset {fQProfile.size()};
+            fQProfile.resize(offset + kNPads);
+            for(const auto& v : cl.GetRefToVoxels())
+            {
+                auto qv {v.GetCharge()};
+                q += qv;
+                auto x {static_cast<int>(v.GetPosition().X())};
+                if(0 <= x && x < kNPads)
+                    fQProfile[offset + x] += qv;
+            }
+            fQ.push_back(q);
+            fNVoxels.push_back(cl.GetRefToVoxels().size());
+            int flags {};
+            if(cl.GetIsBeamLike())
+                flags |= kBeamLike;
+            if(cl.GetFlag("IsRANSAC"))
+                flags |= kRANSAC;
+            if(cl.GetFlag("IsPileUp"))
+                flags |= kPileUp;
+            fFlags.push_back(flags);
+        }
+    }
+};
+
+// Charge of cluster idx in pads X < npads, from the QProfile column
+template <typename T>
+double GetQBelow(const T& qprofile, int idx, int npads)
+{
+    double ret {};
+    for(int x = 0; x < std::min(npads, kNPads); x++)
+        ret += qprofile[idx * kNPads + x];
+    return ret;
+}
+} // namespace ClusterSummary
+
+#endif
@@ -0,0 +1,130 @@
+#ifndef DerivedCache_h
+#define DerivedCache_h
+
+#include "ROOT/RDF/InterfaceUtils.hxx"
+#include "ROOT/RDataFrame.hxx"
+
+#include "TChain.h"
+#include "TFile.h"
+#include "TString.h"
+#include "TSystem.h"
+#include "TSystemDirectory.h"
+#include "TTree.h"
+
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "./IOConfig.h"
+
+// Derived columns computed once over the dataset and stored in ./<dir>/<name>_<key>.root (CacheTree),
+// indexed by (run, entry) so it can be attached as a friend of any chain holding those columns
+// The key hashes the name and the content of all dependency files (macro source and included headers,
+// SRIM tables, cuts, configs): a change in any of them builds a new cache, uncommitted edits included
+class DerivedCache
+{
+private:
+    std::string fName;
+    std::string fDir;
+    std::vector<std::string> fDeps;
+    std::string fRunCol;
+    std::string fEntryCol;
+    std::string fKey;
+    std::unique_ptr<TFile> fFile; //!< Kept open while attached
+
+public:
+    DerivedCache(const std::string& name, const std::string& dir, const std::vector<std::string>& deps,
+                 const std::string& runCol = "fRun", const std::string& entryCol = "fEntry")
+        : fName(name),
+          fDir(dir),
+          fDeps(deps),
+          fRunCol(runCol),
+          fEntryCol(entryCol)
+    {
+        fKey = ComputeKey();
+    }
+
+    const std::string& GetKey() const { return fKey; }
+    std::string GetFile() const { return fDir + fName + "_" + fKey + ".root"; }
+    bool Exists() const { return !gSystem->AccessPathName(GetFile().c_str()); }
+
+    // Snapshot the run and entry columns plus cols of df (one entry per event of the chain) and index them
+    void Build(ROOT::RDF::RNode df, const std::vector<std::string>& cols)
+    {
+        gSystem->mkdir(fDir.c_str(), true);
+        // Remove caches of the same name built with other dependencies
+        TSystemDirectory dir {"dir", fDir.c_str()};
+        auto* files {dir.GetListOfFiles()};
+        auto prefix {fName + "_"};
+        if(files)
+        {
+            for(auto* obj : *files)
+            {
+                TString file {obj->GetName()};
+                // <name>_<16 hex digits key>.root
+                if(file.BeginsWith(prefix) && file.EndsWith(".root") &&
+                   file.Length() == static_cast<Ssiz_t>(prefix.size() + fKey.size() + 5))
+                    gSystem->Unlink((fDir + file.Data()).c_str());
+            }
+            delete files;
+        }
+
+        std::vector<std::string> branches {fRunCol, fEntryCol};
+        branches.insert(branches.end(), cols.begin(), cols.end());
+        auto file {GetFile()};
+        auto opts {IOConfig::GetSnapshotOptions()};
+        opts.fOutputFormat = ROOT::RDF::ESnapshotOutputFormat::kTTree; // BuildIndex and friends need a TTree
+        df.Snapshot("CacheTree", file, branches, opts);
+        // Index so that the friend is found by value and not by entry number (MT snapshots reorder entries)
+        auto f {std::make_unique<TFile>(file.c_str(), "update")};
+        auto* tree {f->Get<TTree>("CacheTree")};
+        tree->BuildIndex(fRunCol.c_str(), fEntryCol.c_str());
+        tree->Write("", TObject::kOverwrite);
+        f->Close();
+        std::cout << "DerivedCache::Build(): " << fName << " -> " << file << '\n';
+    }
+
+    // Add the cache as an indexed friend of chain, with alias fName; call before building the RDataFrame
+    void Attach(TChain* chain)
+    {
+        if(!Exists())
+            throw std::runtime_error("DerivedCache::Attach(): " + GetFile() + " does not exist, Build() it first");
+        fFile.reset(TFile::Open(GetFile().c_str()));
+        auto* tree {fFile->Get<TTree>("CacheTree")};
+        chain->AddFriend(tree, fName.c_str());
+    }
+
+    // 64-bit FNV-1a
+    static void Hash(std::uint64_t& h, const std::string& str)
+    {
+        for(unsigned char c : str)
+        {
+            h ^= c;
+            h *= 1099511628211ull;
+        }
+    }
+
+private:
+
+    std::string ComputeKey() const
+    {
+        std::uint64_t h {14695981039346656037ull};
+        Hash(h, fName);
+        for(const auto& dep : fDeps)
+        {
+            std::ifstream streamer {dep, std::ios::binary};
+            if(!streamer)
+                throw std::runtime_error("DerivedCache::ComputeKey(): could not open dependency " + dep);
+            Hash(h, dep);
+            Hash(h, std::string {std::istreambuf_iterator<char>(streamer), std::istreambuf_iterator<char>()});
+        }
+        return TString::Format("%016llx", static_cast<unsigned long long>(h)).Data();
+    }
+};
+
+#endif
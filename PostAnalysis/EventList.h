@@ -0,0 +1,153 @@
+#ifndef EventList_h
+#define EventList_h
+
+#include "TChain.h"
+#include "TEntryList.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "./ChainUtils.h"
+
+// Sorted list of (run, entry) pairs with a compact binary format (.evl)
+// Entries are local to the run file, as stored by MergerData::fEntry; all stages share them
+class EventList
+{
+public:
+    using Event = std::pair<int, std::int64_t>;
+
+private:
+    static constexpr char kMagic[8] {'S', '2', '0', '0', '8', 'E', 'V', 'L'};
+    static constexpr std::uint32_t kVersion {1};
+    std::vector<Event> fEvents;
+    bool fSorted {true};
+
+public:
+    EventList() = default;
+    EventList(const std::string& file) { Read(file); }
+
+    void Add(int run, std::int64_t entry)
+    {
+        fEvents.push_back({run, entry});
+        fSorted = false;
+    }
+    void Add(const EventList& other)
+    {
+        fEvents.insert(fEvents.end(), other.fEvents.begin(), other.fEvents.end());
+        fSorted = false;
+    }
+    // Sort and remove duplicates; call after adding
+    void Sort()
+    {
+        std::sort(fEvents.begin(), fEvents.end());
+        fEvents.erase(std::unique(fEvents.begin(), fEvents.end()), fEvents.end());
+        fSorted = true;
+    }
+    bool IsSorted() const { return fSorted; }
+    bool Contains(int run, std::int64_t entry) const
+    {
+        CheckSorted("Contains");
+        return std::binary_search(fEvents.begin(), fEvents.end(), Event {run, entry});
+    }
+    std::size_t GetSize() const { return fEvents.size(); }
+    const std::vector<Event>& GetEvents() const { return fEvents; }
+
+    // Binary format: magic, version, size and (int32 run, int64 entry) pairs
+    void Write(const std::string& file)
+    {
+        Sort();
+        std::ofstream streamer {file, std::ios::binary};
+        if(!streamer)
+            throw std::runtime_error("EventList::Write(): could not open " + file);
+        std::uint64_t size {fEvents.size()};
+        streamer.write(kMagic, sizeof(kMagic));
+        streamer.write(reinterpret_cast<const char*>(&kVersion), sizeof(kVersion));
+        streamer.write(reinterpret_cast<const char*>(&size), sizeof(size));
+        for(const auto& [run, entry] : fEvents)
+        {
+            std::int32_t r {run};
+            streamer.write(reinterpret_cast<const char*>(&r), sizeof(r));
+            streamer.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+        }
+    }
+    void Read(const std::string& file)
+    {
+        std::ifstream streamer {file, std::ios::binary};
+        if(!streamer)
+            throw std::runtime_error("EventList::Read(): could not open " + file);
+        char magic[8] {};
+        std::uint32_t version {};
+        std::uint64_t size {};
+        streamer.read(magic, sizeof(magic));
+        streamer.read(reinterpret_cast<char*>(&version), sizeof(version));
+        streamer.read(reinterpret_cast<char*>(&size), sizeof(size));
+        if(std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 || version != kVersion)
+            throw std::runtime_error("EventList::Read(): " + file + " is not an event list");
+        fEvents.resize(size);
+        for(auto& [run, entry] : fEvents)
+        {
+            std::int32_t r {};
+            streamer.read(reinterpret_cast<char*>(&r), sizeof(r));
+            streamer.read(reinterpret_cast<char*>(&entry), sizeof(entry));
+            run = r;
+        }
+        // Written sorted by Write(); a list modified by other means is sorted again
+        fSorted = std::is_sorted(fEvents.begin(), fEvents.end());
+        if(!fSorted)
+            Sort();
+    }
+    // Same text line as MergerData::Stream, from the fRun and fEntry member columns
+    static void Stream(std::ostream& streamer, int run, std::int64_t entry) { streamer << run << " " << entry << '\n'; }
+    // Text files written with MergerData::Stream (run entry per line)
+    void ReadText(const std::string& file)
+    {
+        std::ifstream streamer {file};
+        if(!streamer)
+            throw std::runtime_error("EventList::ReadText(): could not open " + file);
+        int run {};
+        std::int64_t entry {};
+        while(streamer >> run >> entry)
+            Add(run, entry);
+        Sort();
+    }
+
+    // TEntryList for chain, with one sublist per run file
+    TEntryList* GetEntryList(TChain* chain) const
+    {
+        CheckSorted("GetEntryList");
+        auto* ret {new TEntryList {"evl", "EventList"}};
+        auto files {ChainUtils::GetFiles(chain)};
+        for(const auto& file : files)
+        {
+            auto run {ChainUtils::GetRun(file)};
+            auto begin {std::lower_bound(fEvents.begin(), fEvents.end(), Event {run, 0})};
+            auto end {std::lower_bound(fEvents.begin(), fEvents.end(), Event {run + 1, 0})};
+            if(begin == end)
+                continue;
+            TEntryList sub {"", "", chain->GetName(), file.c_str()};
+            for(auto it = begin; it != end; it++)
+                sub.Enter(it->second);
+            ret->Add(&sub);
+        }
+        return ret;
+    }
+    // Restrict chain (and RDataFrames built on it) to the listed events
+    void Apply(TChain* chain) const { chain->SetEntryList(GetEntryList(chain), "ne"); }
+
+private:
+    // Lookups are binary searches over the sorted events
+    void CheckSorted(const std::string& where) const
+    {
+        if(!fSorted)
+            throw std::runtime_error("EventList::" + where + "(): list not sorted, call Sort() after Add()");
+    }
+};
+
+#endif
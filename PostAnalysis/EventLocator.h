@@ -0,0 +1,181 @@
+#ifndef EventLocator_h
+#define EventLocator_h
+
+#include "ActInputParser.h"
+
+#include "TFile.h"
+#include "TString.h"
+#include "TTree.h"
+
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "./ChainUtils.h"
+
+// Persistent (run, entry) -> (file, tree, local entry) index over all the stages of data.conf,
+// stored in ./RootFiles/event_index.root (EventIndex tree, one entry per stage and run)
+// Entries are local to the run file in every stage (MergerData::fEntry), so one event is a single
+// GetEntry per stage once the index is loaded
+class EventLocator
+{
+public:
+    struct Location
+    {
+        std::string fStage;
+        std::string fFile;
+        std::string fTree;
+        Long64_t fEntries {};
+    };
+    // Tree positioned at the requested entry; the file stays open while the record lives
+    struct Record
+    {
+        std::string fStage;
+        std::unique_ptr<TFile> fFile;
+        TTree* fTree {};
+        Long64_t fEntry {};
+    };
+
+private:
+    std::string fPrefix; //!< Prepended to the paths of data.conf (../ from Macros)
+    std::map<std::pair<std::string, int>, Location> fLocations;
+    std::vector<std::string> fStages;
+
+public:
+    static const std::vector<std::string>& GetAllStages()
+    {
+        static const std::vector<std::string> ret {"Raw", "Cluster", "Data", "Filter", "Merger"};
+        return ret;
+    }
+
+    EventLocator(const std::string& prefix = "./") : fPrefix(prefix) {}
+
+    // Scan the files of every stage for runs and store their entries and tree names
+    void Build(const std::string& dataconf, const std::vector<int>& runs)
+    {
+        ActRoot::InputParser parser {dataconf};
+        auto headers {parser.GetBlockHeaders()};
+        for(const auto& stage : GetAllStages())
+        {
+            if(std::find(headers.begin(), headers.end(), stage) == headers.end())
+                continue;
+            auto block {parser.GetBlock(stage)};
+            auto tree {block->GetString("TreeName")};
+            auto path {block->GetString("Path")};
+            auto begin {block->GetString("Begin")};
+            auto end {block->CheckTokenExists("End") ? block->GetString("End") : ""};
+            for(auto run : runs)
+            {
+                auto file {ChainUtils::GetFileName(path, begin, run, end)};
+                auto f {std::unique_ptr<TFile>(TFile::Open((fPrefix + file).c_str()))};
+                if(!f || f->IsZombie())
+                    continue;
+                auto* t {f->Get<TTree>(tree.c_str())};
+                if(!t)
+                    continue;
+                fLocations[{stage, run}] = {stage, file, tree, t->GetEntries()};
+            }
+            fStages.push_back(stage);
+        }
+    }
+
+    void Write(const std::string& file) const
+    {
+        auto f {std::make_unique<TFile>((fPrefix + file).c_str(), "recreate")};
+        auto* tree {new TTree {"EventIndex", "(run, entry) locations per stage"}};
+        std::string stage, name, treeName;
+        int run {};
+        Long64_t entries {};
+        tree->Branch("Stage", &stage);
+        tree->Branch("Run", &run);
+        tree->Branch("File", &name);
+        tree->Branch("Tree", &treeName);
+        tree->Branch("Entries", &entries);
+        for(const auto& [key, loc] : fLocations)
+        {
+            stage = loc.fStage;
+            run = key.second;
+            name = loc.fFile;
+            treeName = loc.fTree;
+            entries = loc.fEntries;
+            tree->Fill();
+        }
+        tree->Write();
+        f->Close();
+    }
+
+    void Read(const std::string& file)
+    {
+        auto f {std::unique_ptr<TFile>(TFile::Open((fPrefix + file).c_str()))};
+        if(!f)
+            throw std::runtime_error("EventLocator::Read(): could not open " + fPrefix + file +
+                                     ", build it with fetchEvent.cxx");
+        auto* tree {f->Get<TTree>("EventIndex")};
+        std::string *stage {}, *name {}, *treeName {};
+        int run {};
+        Long64_t entries {};
+        tree->SetBranchAddress("Stage", &stage);
+        tree->SetBranchAddress("Run", &run);
+        tree->SetBranchAddress("File", &name);
+        tree->SetBranchAddress("Tree", &treeName);
+        tree->SetBranchAddress("Entries", &entries);
+        for(Long64_t i = 0; i < tree->GetEntries(); i++)
+        {
+            tree->GetEntry(i);
+            fLocations[{*stage, run}] = {*stage, *name, *treeName, entries};
+            if(std::find(fStages.begin(), fStages.end(), *stage) == fStages.end())
+                fStages.push_back(*stage);
+        }
+    }
+
+    const std::vector<std::string>& GetStages() const { return fStages; }
+
+    // Location of (run, entry) in stage, or nullptr if not indexed or out of range
+    const Location* Locate(const std::string& stage, int run, Long64_t entry) const
+    {
+        auto it {fLocations.find({stage, run})};
+        if(it == fLocations.end() || entry < 0 || entry >= it->second.fEntries)
+            return nullptr;
+        return &it->second;
+    }
+
+    Record Fetch(const std::string& stage, int run, Long64_t entry) const
+    {
+        Record ret;
+        ret.fStage = stage;
+        ret.fEntry = entry;
+        auto* loc {Locate(stage, run, entry)};
+        if(!loc)
+            return ret;
+        ret.fFile.reset(TFile::Open((fPrefix + loc->fFile).c_str()));
+        if(!ret.fFile)
+            return ret;
+        ret.fTree = ret.fFile->Get<TTree>(loc->fTree.c_str());
+        if(ret.fTree)
+            ret.fTree->GetEntry(entry);
+        return ret;
+    }
+
+    // Dump the full record of the event in all (or the requested) stages
+    void Print(int run, Long64_t entry, const std::vector<std::string>& stages = {}) const
+    {
+        for(const auto& stage : (stages.empty() ? fStages : stages))
+        {
+            std::cout << "===== " << stage << " : run " << run << " entry " << entry << " =====" << '\n';
+            auto record {Fetch(stage, run, entry)};
+            if(!record.fTree)
+            {
+                std::cout << "  not available" << '\n';
+                continue;
+            }
+            record.fTree->Show(entry);
+        }
+    }
+};
+
+#endif
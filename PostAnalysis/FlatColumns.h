@@ -0,0 +1,92 @@
+#ifndef FlatColumns_h
+#define FlatColumns_h
+
+#include "ActMergerData.h"
+#include "ActModularData.h"
+
+#include "ROOT/RDF/InterfaceUtils.hxx"
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+// Flat scalar columns written by Pipe1 in PID_Tree and carried to Final_Tree,
+// so later pipes read only the columns they use instead of whole MergerData objects
+namespace FlatColumns
+{
+// Layer where the light particle stops (first silicon layer) or L1
+enum ELayer : unsigned char
+{
+    kNone = 0,
+    kF0,
+    kF1,
+    kL0,
+    kR0,
+    kL1,
+};
+
+inline unsigned char GetLayerCode(const ActRoot::MergerData& m)
+{
+    if(m.fLight.IsL1())
+        return kL1;
+    if(m.fLight.fLayers.empty())
+        return kNone;
+    const auto& layer {m.fLight.fLayers.front()};
+    if(layer == "f0")
+        return kF0;
+    if(layer == "f1")
+        return kF1;
+    if(layer == "l0")
+        return kL0;
+    if(layer == "r0")
+        return kR0;
+    return kNone;
+}
+
+// Has silicon energy (light stopped in or punched through a silicon layer)
+inline bool HasSil(unsigned char code)
+{
+    return code != kNone && code != kL1;
+}
+
+inline const std::vector<std::string>& GetColumns()
+{
+    static const std::vector<std::string> ret {"Run",        "Entry",      "LightIdx",  "Trigger", "LayerCode",
+                                               "RPx",        "RPy",        "RPz",       "SPx",     "SPy",
+                                               "SPz",        "ThetaLight", "ThetaHeavy", "ThetaBeam", "ESil0",
+                                               "ESil1",      "TL",         "HeavyTL",   "Qave",    "Qtotal",
+                                               "RawTL"};
+    return ret;
+}
+
+// Defines the flat columns from MergerData and ModularData
+inline ROOT::RDF::RNode Define(ROOT::RDF::RNode df)
+{
+    return df.Define("Run", [](const ActRoot::MergerData& m) { return m.fRun; }, {"MergerData"})
+        .Define("Entry", [](const ActRoot::MergerData& m) { return m.fEntry; }, {"MergerData"})
+        .Define("LightIdx", [](const ActRoot::MergerData& m) { return m.fLightIdx; }, {"MergerData"})
+        .Define("Trigger", [](ActRoot::ModularData& mod) { return static_cast<int>(mod.Get("GATCONF")); },
+                {"ModularData"})
+        .Define("LayerCode", [](const ActRoot::MergerData& m) { return GetLayerCode(m); }, {"MergerData"})
+        .Define("RPx", [](const ActRoot::MergerData& m) { return m.fRP.X(); }, {"MergerData"})
+        .Define("RPy", [](const ActRoot::MergerData& m) { return m.fRP.Y(); }, {"MergerData"})
+        .Define("RPz", [](const ActRoot::MergerData& m) { return m.fRP.Z(); }, {"MergerData"})
+        .Define("SPx", [](const ActRoot::MergerData& m) { return m.fSP.X(); }, {"MergerData"})
+        .Define("SPy", [](const ActRoot::MergerData& m) { return m.fSP.Y(); }, {"MergerData"})
+        .Define("SPz", [](const ActRoot::MergerData& m) { return m.fSP.Z(); }, {"MergerData"})
+        .Define("ThetaLight", [](const ActRoot::MergerData& m) { return m.fThetaLight; }, {"MergerData"})
+        .Define("ThetaHeavy", [](const ActRoot::MergerData& m) { return m.fThetaHeavy; }, {"MergerData"})
+        .Define("ThetaBeam", [](const ActRoot::MergerData& m) { return m.fThetaBeam; }, {"MergerData"})
+        .Define("ESil0", [](const ActRoot::MergerData& m)
+                { return m.fLight.fEs.size() > 0 ? m.fLight.fEs[0] : NAN; }, {"MergerData"})
+        .Define("ESil1", [](const ActRoot::MergerData& m)
+                { return m.fLight.fEs.size() > 1 ? m.fLight.fEs[1] : NAN; }, {"MergerData"})
+        .Define("TL", [](const ActRoot::MergerData& m) { return m.fLight.fTL; }, {"MergerData"})
+        .Define("HeavyTL", [](const ActRoot::MergerData& m) { return m.fHeavy.fTL; }, {"MergerData"})
+        .Define("Qave", [](const ActRoot::MergerData& m) { return m.fLight.fQave; }, {"MergerData"})
+        .Define("Qtotal", [](const ActRoot::MergerData& m) { return m.fLight.fQtotal; }, {"MergerData"})
+        .Define("RawTL", [](const ActRoot::MergerData& m) { return m.fLight.fRawTL; }, {"MergerData"});
+}
+} // namespace FlatColumns
+
+#endif
@@ -38,6 +38,12 @@ const TH2DModel ZThetaZ {"hZThetaZ", "Emittance along Z;Z [mm];#theta_{Z} [#circ
 
 const TH2DModel YPhiY {"hYPhiY", "Emittance along Y;Y [mm];#phi_{Y} [#circ]", 600, 0, 270, 600, -10, 10};
 
+// Same in pad units, as the cluster lines (angles are those of the lines in pad units too)
+const TH2DModel ZThetaZPads {
+    "hZThetaZPads", "Emittance along Z;Z_{0} [pad];#theta_{Z} [#circ]", 600, 0, 135, 600, -10, 10};
+
+const TH2DModel YPhiYPads {"hYPhiYPads", "Emittance along Y;Y_{0} [pad];#phi_{Y} [#circ]", 600, 0, 135, 600, -10, 10};
+
 const TH2DModel ThetaBeam {
     "hThetaBeam", "#theta_{Beam} against RP.X;RP.X() [mm];#theta_{Beam} [#circ]", 200, -5, 270, 200, -1, 10};
 
@@ -0,0 +1,118 @@
+#ifndef IOConfig_h
+#define IOConfig_h
+
+#include "ActInputParser.h"
+
+#include "Compression.h"
+#include "ROOT/RDF/InterfaceUtils.hxx"
+#include "ROOT/RDataFrame.hxx"
+#include "ROOT/RSnapshotOptions.hxx"
+
+#include "TSystem.h"
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Output format and read helpers shared by all pipes and macros reading their outputs
+namespace IOConfig
+{
+// Write PID_Tree/Final_Tree as RNTuple instead of TTree; set by Runner
+inline bool& UseRNTuple()
+{
+    static bool ret {false};
+    return ret;
+}
+
+// Snapshot profile: "default", "fast" or "archive"; empty reads it from configs/snapshot.conf. Set by Runner
+inline std::string& Profile()
+{
+    static std::string ret {};
+    return ret;
+}
+
+// configs/snapshot.conf seen from the repo root, PostAnalysis or Macros; empty if not found
+inline std::string GetSnapshotConf()
+{
+    for(const std::string file : {"./configs/snapshot.conf", "../configs/snapshot.conf"})
+        if(!gSystem->AccessPathName(file.c_str()))
+            return file;
+    return "";
+}
+
+inline std::shared_ptr<ActRoot::InputBlock> GetSnapshotBlock(const std::string& name)
+{
+    auto conf {GetSnapshotConf()};
+    if(conf.empty())
+        return nullptr;
+    ActRoot::InputParser parser {conf};
+    auto headers {parser.GetBlockHeaders()};
+    if(std::find(headers.begin(), headers.end(), name) == headers.end())
+        return nullptr;
+    return parser.GetBlock(name);
+}
+
+inline std::string GetProfile()
+{
+    if(Profile().size())
+        return Profile();
+    if(auto block {GetSnapshotBlock("Snapshot")}; block && block->CheckTokenExists("Profile"))
+        return block->GetString("Profile");
+    return "default";
+}
+
+// Options of every Snapshot in pipes and macros: output format plus the compression of the active profile
+// fast: LZ4 and small baskets, for outputs rewritten often; archive: ZSTD at the highest level, for final trees
+inline ROOT::RDF::RSnapshotOptions GetSnapshotOptions()
+{
+    ROOT::RDF::RSnapshotOptions opts;
+    if(UseRNTuple())
+        opts.fOutputFormat = ROOT::RDF::ESnapshotOutputFormat::kRNTuple;
+    auto profile {GetProfile()};
+    if(profile == "fast")
+    {
+        opts.fCompressionAlgorithm = ROOT::RCompressionSetting::EAlgorithm::kLZ4;
+        opts.fCompressionLevel = 1;
+        opts.fBasketSize = 16 * 1024;
+    }
+    else if(profile == "archive")
+    {
+        opts.fCompressionAlgorithm = ROOT::RCompressionSetting::EAlgorithm::kZSTD;
+        opts.fCompressionLevel = 9;
+        opts.fBasketSize = 256 * 1024;
+    }
+    else if(profile != "default")
+        std::cout << "IOConfig::GetSnapshotOptions(): unknown profile " << profile << ", using default" << '\n';
+    return opts;
+}
+
+// Columns of the producer (pipe or macro name) in the [Columns] block of configs/snapshot.conf, otherwise cols
+inline std::vector<std::string> GetColumns(const std::string& key, const std::vector<std::string>& cols = {})
+{
+    if(auto block {GetSnapshotBlock("Columns")}; block && block->CheckTokenExists(key))
+        return block->GetStringVector(key);
+    return cols;
+}
+
+// Snapshot with the columns and options of configs/snapshot.conf; no columns at all writes every column
+inline ROOT::RDF::RResultPtr<ROOT::RDF::RInterface<ROOT::Detail::RDF::RLoopManager>>
+Snapshot(ROOT::RDF::RNode df, const std::string& key, const std::string& tree, const std::string& file,
+         const std::vector<std::string>& cols = {}, const ROOT::RDF::RSnapshotOptions& opts = GetSnapshotOptions())
+{
+    auto columns {GetColumns(key, cols)};
+    if(columns.empty())
+        return df.Snapshot(tree, file, "", opts);
+    return df.Snapshot(tree, file, columns, opts);
+}
+
+// Opens a pipe output written either as TTree or RNTuple; pipes write flat columns (FlatColumns.h),
+// so both formats have the same column names
+inline ROOT::RDF::RNode Read(const std::string& name, const std::string& file)
+{
+    return ROOT::RDataFrame {name, file};
+}
+} // namespace IOConfig
+
+#endif
@@ -0,0 +1,186 @@
+#ifndef LiveServer_h
+#define LiveServer_h
+
+#include "ROOT/RResultPtr.hxx"
+
+#include "THttpServer.h"
+#include "TH1.h"
+#include "TString.h"
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Live view of the pipe histograms on http://localhost:<port> while the event loop runs
+// Enabled by Runner with a non-zero port; every registered histogram is shown as the sum of the latest
+// per-slot partial results, refreshed every kEvery entries per slot, plus the total of the finished runs
+// in run-by-run loops (PublishTotal)
+namespace LiveServer
+{
+constexpr unsigned long kEvery {50000};
+
+// 0 disables live publishing; set by Runner
+inline int& Port()
+{
+    static int ret {0};
+    return ret;
+}
+inline bool IsEnabled()
+{
+    return Port() > 0;
+}
+
+class Server
+{
+private:
+    struct Entry
+    {
+        std::unique_ptr<TH1> fDisplay;
+        std::unique_ptr<TH1> fTotal;                        //!< Already finished part of the job (SetTotal)
+        std::map<std::size_t, std::unique_ptr<TH1>> fParts; //!< Latest partial result per slot (or thread)
+    };
+    std::unique_ptr<THttpServer> fServer;
+    std::map<std::string, Entry> fEntries;
+    std::mutex fMutex; //!< Held by Update() and while requests are served
+    std::thread fThread;
+    std::atomic<bool> fStop {false};
+
+    Server()
+    {
+        // Loopback only: nothing is exposed outside this machine
+        fServer = std::make_unique<THttpServer>(TString::Format("http:%d?loopback", Port()));
+        // Requests are served only by this thread and under fMutex, so a histogram is never streamed while
+        // Update() refills it (no timer processing them from the main thread either)
+        fServer->SetTimer(0);
+        fThread = std::thread {[this]
+                               {
+                                   while(!fStop)
+                                   {
+                                       {
+                                           std::lock_guard<std::mutex> lock {fMutex};
+                                           fServer->ProcessRequests();
+                                       }
+                                       std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                                   }
+                               }};
+        std::cout << "LiveServer: histograms at http://localhost:" << Port() << '\n';
+    }
+    ~Server()
+    {
+        fStop = true;
+        if(fThread.joinable())
+            fThread.join();
+    }
+
+public:
+    static Server& Get()
+    {
+        static Server ret;
+        return ret;
+    }
+    Server(const Server&) = delete;
+    Server& operator=(const Server&) = delete;
+
+    // Copy the partial result of one slot and rebuild the displayed sum
+    void Update(const std::string& folder, const std::string& name, const TH1& h, std::size_t key)
+    {
+        std::lock_guard<std::mutex> lock {fMutex};
+        auto& entry {GetEntry(folder, name, h)};
+        auto& part {entry.fParts[key]};
+        if(!part)
+        {
+            part.reset(static_cast<TH1*>(h.Clone()));
+            part->SetDirectory(nullptr);
+        }
+        else
+        {
+            part->Reset();
+            part->Add(&h);
+        }
+        Rebuild(entry);
+    }
+
+    // Start a new pass (ex: the next run of a run-by-run loop): drop the partial results and show total
+    // (nullptr if nothing finished yet) until the new ones arrive
+    void SetTotal(const std::string& folder, const std::string& name, const TH1* total)
+    {
+        std::lock_guard<std::mutex> lock {fMutex};
+        auto it {fEntries.find(folder + "/" + name)};
+        if(it == fEntries.end() && !total)
+            return;
+        auto& entry {it != fEntries.end() ? it->second : GetEntry(folder, name, *total)};
+        entry.fParts.clear();
+        entry.fTotal.reset();
+        if(total)
+        {
+            entry.fTotal.reset(static_cast<TH1*>(total->Clone()));
+            entry.fTotal->SetDirectory(nullptr);
+        }
+        Rebuild(entry);
+    }
+
+private:
+    // Entry of folder/name, registering its display histogram (a copy of h) the first time
+    Entry& GetEntry(const std::string& folder, const std::string& name, const TH1& h)
+    {
+        auto& entry {fEntries[folder + "/" + name]};
+        if(!entry.fDisplay)
+        {
+            entry.fDisplay.reset(static_cast<TH1*>(h.Clone(name.c_str())));
+            entry.fDisplay->SetDirectory(nullptr);
+            fServer->Register(folder.c_str(), entry.fDisplay.get());
+        }
+        return entry;
+    }
+
+    void Rebuild(Entry& entry)
+    {
+        entry.fDisplay->Reset();
+        if(entry.fTotal)
+            entry.fDisplay->Add(entry.fTotal.get());
+        for(const auto& [_, p] : entry.fParts)
+            entry.fDisplay->Add(p.get());
+    }
+};
+
+// Publish an RDataFrame result while it is being filled; name defaults to the histogram name
+template <typename T>
+void Publish(const std::string& folder, ROOT::RDF::RResultPtr<T>& result, const std::string& name = "")
+{
+    if(!IsEnabled())
+        return;
+    result.OnPartialResultSlot(kEvery, [folder, name](unsigned int slot, T& h)
+                               { Server::Get().Update(folder, name.empty() ? h.GetName() : name, h, slot); });
+}
+
+// True once every kEvery calls from the calling thread; call it once per entry before PublishThreaded
+inline bool IsTime()
+{
+    if(!IsEnabled())
+        return false;
+    thread_local unsigned long counter {};
+    return ++counter % kEvery == 0;
+}
+
+// Publish a TThreadedObject histogram from the filling thread (its slot is bound to the thread)
+inline void PublishThreaded(const std::string& folder, const std::string& name, const TH1& h)
+{
+    Server::Get().Update(folder, name, h, std::hash<std::thread::id> {}(std::this_thread::get_id()));
+}
+
+// Show total (finished runs) plus the partial results published from now on
+inline void PublishTotal(const std::string& folder, const std::string& name, const TH1* total)
+{
+    if(!IsEnabled())
+        return;
+    Server::Get().SetTotal(folder, name, total);
+}
+} // namespace LiveServer
+
+#endif
@@ -1,8 +1,6 @@
-#include "ActCluster.h"
 #include "ActDataManager.h"
 #include "ActMergerData.h"
 #include "ActModularData.h"
-#include "ActTPCData.h"
 #include "ActTypes.h"
 
 #include "ROOT/RDataFrame.hxx"
@@ -13,6 +11,12 @@
 #include <atomic>
 #include <utility>
 
+#include "../ChainCatalog.h"
+#include "../ChainUtils.h"
+#include "../ClusterSummary.h"
+#include "../LiveServer.h"
+#include "../Sampling.h"
+
 void Pipe0_Beam(const std::string& beam)
 {
     std::string dataconf {"./../configs/data.conf"};
@@ -21,10 +25,15 @@ void Pipe0_Beam(const std::string& beam)
     // Read data
     ActRoot::DataManager datman {dataconf, ActRoot::ModeType::EReadSilMod};
     auto chain {datman.GetJoinedData()};
-    auto chain2 {datman.GetChain(ActRoot::ModeType::EFilter)};
-    auto chain3 {datman.GetChain(ActRoot::ModeType::EMerge)};
+    // Merger from its catalog, so no file is opened to count entries (ChainCatalog.h)
+    auto chain2 {ChainCatalog::GetUpdatedChain(dataconf, "Merger", ChainUtils::GetRuns(chain.get()))};
     chain->AddFriend(chain2.get());
-    ROOT::RDataFrame df {*chain};
+    // Cluster summary instead of full TPCData (runClusterSummary.cxx)
+    auto chain3 {ChainUtils::GetSidecar(chain2.get(), "../RootFiles/Summary/", "Summary_Run_", "SummaryTree")};
+    chain->AddFriend(chain3.get());
+    ROOT::RDataFrame d {*chain};
+    // Quick-look sample of the runs (Runner with sample < 1)
+    auto df {Sampling::Filter(d, "fRun", "fEntry")};
 
     // Get GATCONF values
     auto defGat {df.Define("GATCONF", [](ActRoot::ModularData& mod)
@@ -33,23 +42,13 @@ void Pipe0_Beam(const std::string& beam)
     // Get plots for DE/E for beam, first 10 pads, until x = 10.
     auto defBeam {defGat.Filter("fBeamIdx != -1")
                       .Define("Pair",
-                              [](ActRoot::TPCData& d, ActRoot::MergerData& m)
+                              [](const ROOT::RVecF& q, const ROOT::RVecF& qprofile, int beamIdx)
                               {
-                                  int beamIdx {m.fBeamIdx};
-                                  auto beamCluster {d.fClusters[beamIdx]};
-                                  auto voxels {beamCluster.GetRefToVoxels()};
-                                  double dE {0}; // DeltaE in first 10 pads
-                                  double E {};   // Total energy
-                                  for(auto& v : voxels)
-                                  {
-                                      auto q {v.GetCharge()};
-                                      if(v.GetPosition().X() < 10)
-                                          dE += q;
-                                      E += q;
-                                  }
+                                  double dE {ClusterSummary::GetQBelow(qprofile, beamIdx, 10)}; // DeltaE in first 10 pads
+                                  double E {q[beamIdx]};                                         // Total energy
                                   return std::make_pair(dE, E);
                               },
-                              {"TPCData", "MergerData"})
+                              {"Q", "QProfile", "fBeamIdx"})
                       .Define("dE", "Pair.first")
                       .Define("E", "Pair.second")};
 
@@ -57,6 +56,8 @@ void Pipe0_Beam(const std::string& beam)
     auto hGATCONF {defGat.Histo1D("GATCONF")};
     auto hdEE {
         defBeam.Histo2D({"hdEE", "Beam ID;Q_{total} [au];Q_{10 pads} [au]", 300, 0, 1e5, 300, 0, 1e5}, "E", "dE")};
+    LiveServer::Publish("Pipe0", hGATCONF);
+    LiveServer::Publish("Pipe0", hdEE);
 
     // And cound CFA triggers
     std::atomic<unsigned long int> cfa {};
@@ -79,5 +80,7 @@ void Pipe0_Beam(const std::string& beam)
     // Print report
     std::cout << "===== GATCONF report =====" << '\n';
     std::cout << "-> CFA/div = " << cfa << '\n';
+    if(Sampling::IsEnabled())
+        std::cout << "-> CFA/div (full estimate) = " << cfa / Sampling::Fraction() << '\n';
     std::cout << "==========================" << '\n';
 }
@@ -1,5 +1,6 @@
 #include "ActCutsManager.h"
 #include "ActDataManager.h"
+#include "ActInputParser.h"
 #include "ActKinematics.h"
 #include "ActMergerData.h"
 #include "ActModularData.h"
@@ -15,6 +16,17 @@
 
 #include <map>
 #include <string>
+#include <vector>
+
+#include "../AnalysisTree.h"
+#include "../Checkpoint.h"
+#include "../ChainUtils.h"
+#include "../FlatColumns.h"
+#include "../IOConfig.h"
+#include "../LiveServer.h"
+#include "../RunPrefetcher.h"
+#include "../Sampling.h"
+#include "../SilIndex.h"
 
 void Pipe1_PID(const std::string& beam, const std::string& target, const std::string& light)
 {
@@ -22,15 +34,23 @@ void Pipe1_PID(const std::string& beam, const std::string& target, const std::st
 
     // Read data
     ActRoot::DataManager dataman {dataconf, ActRoot::ModeType::EMerge};
-    auto chain {dataman.GetChain()};
-    auto chainSil {dataman.GetChain(ActRoot::ModeType::EReadSilMod)};
-    chain->AddFriend(chainSil.get());
-    auto chainFilter {dataman.GetChain(ActRoot::ModeType::EFilter)};
-    chain->AddFriend(chainFilter.get());
+    // Single analysis tree (runAnalysisTree.cxx) or Merger + Data + Filter friends
+    auto chain {GetAnalysisChain(dataman, "../RootFiles/Analysis/", dataconf)};
+
+    // Geometric match of SP with the silicon that fired, with the merger's EnableMatch and MatchUseZ
+    ActRoot::InputParser detParser {"./../configs/detector.conf"};
+    auto merBlock {detParser.GetBlock("Merger")};
+    bool enableMatch {merBlock->CheckTokenExists("EnableMatch") && merBlock->GetBool("EnableMatch")};
+    bool matchUseZ {merBlock->CheckTokenExists("MatchUseZ") && merBlock->GetBool("MatchUseZ")};
+    SilIndex silIndex {"./../configs/silspecs.conf", {"f0", "f1", "l0", "r0"}, matchUseZ};
+    auto lambdaMatch {[&](ActRoot::MergerData& m)
+                      {
+                          if(!enableMatch || m.fLight.IsL1() || m.fLight.fNs.empty())
+                              return true;
+                          return silIndex.IsMatch(m.fLight.GetLayer(0), m.fLight.fNs.front(), m.fLight.fSP);
+                      }};
 
-    // RDataFrame
     ROOT::EnableImplicitMT();
-    ROOT::RDataFrame df {*chain};
 
     // LIGHT particle
     // Define lambda functions
@@ -53,54 +73,6 @@ void Pipe1_PID(const std::string& beam, const std::string& target, const std::st
                          return false;
                      }};
 
-    // Fill histograms
-    std::map<std::string, ROOT::TThreadedObject<TH2D>> hsgas, hstwo;
-    // Histogram models
-    auto hGasSil {new TH2D {"hGasSil", ";E_{Sil} [MeV];#Delta E_{gas} [arb. units]", 450, 0, 70, 600, 0, 3000}};
-    auto hTwoSils {new TH2D {"hTwoSils", ";#DeltaE_{0} [MeV];#DeltaE_{1} [MeV]", 500, 0, 80, 400, 0, 30}};
-    for(const auto& layer : {"f0", "l0", "r0"})
-    {
-        hsgas.emplace(layer, *hGasSil);
-        hsgas[layer]->SetTitle(TString::Format("%s", layer));
-    }
-    hstwo.emplace("f0-f1", *hTwoSils);
-    hstwo["f0-f1"]->SetTitle("f0-f1");
-    ROOT::TThreadedObject<TH2D> hl1 {"hl1", "L1 PID;Raw TL [au];Q_{total} [au]", 200, 0, 120, 2000, 0, 3e5};
-    ROOT::TThreadedObject<TH2D> hl1Gated {"hl1", "L1 PID > 100#circ;Raw TL [au];Q_{total} [au]", 200, 0, 120, 2000, 0,
-                                          3e5};
-    ROOT::TThreadedObject<TH2D> hl1theta {
-        "hl1theta", "L1 #theta;#theta_{L1} [#circ];Q_{total} [au]", 240, 0, 180, 2000, 0, 3e5};
-    ROOT::TThreadedObject<TH2D> hl1thetaCorr {
-        "hl1thetaCorr", "L1 #thetas;#theta_{Light} [#circ];#theta_{Heavy} [#circ]", 240, 0, 180, 200, 0, 100};
-
-    // Fill them
-    df.Foreach(
-        [&](ActRoot::MergerData& m, ActRoot::ModularData& mod, ActRoot::TPCData& tpc)
-        {
-            // L1
-            if(lambdaIsL1(m, mod, tpc))
-            {
-                hl1->Fill(m.fLight.fRawTL, m.fLight.fQtotal);
-                hl1theta->Fill(m.fThetaLight, m.fLight.fQtotal);
-                hl1thetaCorr->Fill(m.fThetaLight, m.fThetaHeavy);
-                if(m.fThetaLight > 100)
-                    hl1Gated->Fill(m.fLight.fRawTL, m.fLight.fQtotal);
-                return;
-            }
-            // Light
-            if(lambdaOne(m)) // Gas-E0 PID
-            {
-                auto layer {m.fLight.GetLayer(0)};
-                if(hsgas.count(layer))
-                    hsgas[layer]->Fill(m.fLight.fEs.front(), m.fLight.fQave);
-            }
-            else if(lambdaTwo(m)) // E0-E1 PID
-            {
-                hstwo["f0-f1"]->Fill(m.fLight.fEs[0], m.fLight.fEs[1]);
-            }
-        },
-        {"MergerData", "ModularData", "TPCData"});
-
     // If cuts are present, apply them
     ActRoot::CutsManager<std::string> cuts;
     // Gas PID
@@ -113,79 +85,199 @@ void Pipe1_PID(const std::string& beam, const std::string& target, const std::st
     // cuts.ReadCut("f0-f1", TString::Format("./Cuts/pid_%s_f0_f1_%s.root", light.c_str(), beam.c_str()).Data());
     // Get list of cuts
     auto listOfCuts {cuts.GetListOfKeys()};
-    if(listOfCuts.size())
+
+    // Histogram models
+    auto hGasSil {new TH2D {"hGasSil", ";E_{Sil} [MeV];#Delta E_{gas} [arb. units]", 450, 0, 70, 600, 0, 3000}};
+    auto hTwoSils {new TH2D {"hTwoSils", ";#DeltaE_{0} [MeV];#DeltaE_{1} [MeV]", 500, 0, 80, 400, 0, 30}};
+
+    // Resumable pass: runs are processed one by one and checkpointed (histograms + PID_Tree part)
+    auto name {Sampling::GetFile(
+        TString::Format("./Outputs/tree_pid_%s_%s_%s.root", beam.c_str(), target.c_str(), light.c_str()).Data())};
+    // Everything the results depend on: this source, the headers shaping selection and output, configs and cuts
+    std::vector<std::string> deps {"./Pipes/Pipe1_PID.cxx", "./AnalysisTree.h", "./FlatColumns.h", "./IOConfig.h",
+                                   "./Sampling.h", "./SilIndex.h", dataconf, "./../configs/detector.conf",
+                                   "./../configs/silspecs.conf", "./../configs/snapshot.conf"};
+    for(const auto& cut : {"l0", "r0", "f0", "l1"})
+        deps.push_back(TString::Format("./Cuts/pid_%s_%s_%s.root", light.c_str(), cut, beam.c_str()).Data());
+    Checkpoint ckpt {TString::Format("Pipe1_PID_%s_%s_%s%s", beam.c_str(), target.c_str(), light.c_str(),
+                                     Sampling::GetSuffix().c_str())
+                         .Data(),
+                     ChainUtils::GetRuns(chain.fChain.get()), deps,
+                     ChainUtils::GetFilesWithFriends(chain.fChain.get())};
+    // Live view: total of the finished runs plus the per-thread parts of the current one
+    std::vector<std::string> liveKeys {"hGasSil_f0", "hGasSil_l0", "hGasSil_r0", "hTwoSils_f0-f1", "hl1", "hl1theta"};
+    // Read ahead the files of the next pending runs while processing the current one
+    auto pending {ckpt.GetPending()};
+    RunPrefetcher prefetcher {chain.fChain.get(), pending};
+    for(auto run : pending)
     {
-        // Apply PID and save in file
-        auto gated {df.Filter(
+        prefetcher.Notify(run);
+        for(const auto& key : liveKeys)
+            LiveServer::PublishTotal("Pipe1", key, ckpt.Get(key));
+        dataman.SetRuns(run, run);
+        auto runChain {GetAnalysisChain(dataman, "../RootFiles/Analysis/", dataconf)};
+        ROOT::RDataFrame d {*runChain};
+        // Quick-look sample of the runs (Runner with sample < 1)
+        auto df {Sampling::Filter(d, "fRun", "fEntry")};
+
+        // Fill histograms
+        std::map<std::string, ROOT::TThreadedObject<TH2D>> hsgas, hstwo;
+        for(const auto& layer : {"f0", "l0", "r0"})
+        {
+            hsgas.emplace(layer, *hGasSil);
+            hsgas[layer]->SetTitle(TString::Format("%s", layer));
+        }
+        hstwo.emplace("f0-f1", *hTwoSils);
+        hstwo["f0-f1"]->SetTitle("f0-f1");
+        ROOT::TThreadedObject<TH2D> hl1 {"hl1", "L1 PID;Raw TL [au];Q_{total} [au]", 200, 0, 120, 2000, 0, 3e5};
+        ROOT::TThreadedObject<TH2D> hl1Gated {
+            "hl1", "L1 PID > 100#circ;Raw TL [au];Q_{total} [au]", 200, 0, 120, 2000, 0, 3e5};
+        ROOT::TThreadedObject<TH2D> hl1theta {
+            "hl1theta", "L1 #theta;#theta_{L1} [#circ];Q_{total} [au]", 240, 0, 180, 2000, 0, 3e5};
+        ROOT::TThreadedObject<TH2D> hl1thetaCorr {
+            "hl1thetaCorr", "L1 #thetas;#theta_{Light} [#circ];#theta_{Heavy} [#circ]", 240, 0, 180, 200, 0, 100};
+
+        // Fill them
+        df.Foreach(
             [&](ActRoot::MergerData& m, ActRoot::ModularData& mod, ActRoot::TPCData& tpc)
             {
+                // Live view of this thread's histograms (Runner with a live port)
+                if(LiveServer::IsTime())
+                {
+                    for(auto& [layer, h] : hsgas)
+                        LiveServer::PublishThreaded("Pipe1", "hGasSil_" + layer, *h.Get());
+                    for(auto& [layer, h] : hstwo)
+                        LiveServer::PublishThreaded("Pipe1", "hTwoSils_" + layer, *h.Get());
+                    LiveServer::PublishThreaded("Pipe1", "hl1", *hl1.Get());
+                    LiveServer::PublishThreaded("Pipe1", "hl1theta", *hl1theta.Get());
+                }
                 // L1
                 if(lambdaIsL1(m, mod, tpc))
                 {
-                    if(cuts.GetCut("l1"))
-                        return cuts.IsInside("l1", m.fLight.fRawTL, m.fLight.fQtotal);
-                    else
-                        return false;
+                    hl1->Fill(m.fLight.fRawTL, m.fLight.fQtotal);
+                    hl1theta->Fill(m.fThetaLight, m.fLight.fQtotal);
+                    hl1thetaCorr->Fill(m.fThetaLight, m.fThetaHeavy);
+                    if(m.fThetaLight > 100)
+                        hl1Gated->Fill(m.fLight.fRawTL, m.fLight.fQtotal);
+                    return;
                 }
-                // One silicon
-                else if(lambdaOne(m))
+                if(enableMatch && !lambdaMatch(m))
+                    return;
+                // Light
+                if(lambdaOne(m)) // Gas-E0 PID
                 {
                     auto layer {m.fLight.GetLayer(0)};
-                    if(cuts.GetCut(layer))
+                    if(hsgas.count(layer))
+                        hsgas[layer]->Fill(m.fLight.fEs.front(), m.fLight.fQave);
+                }
+                else if(lambdaTwo(m)) // E0-E1 PID
+                {
+                    hstwo["f0-f1"]->Fill(m.fLight.fEs[0], m.fLight.fEs[1]);
+                }
+            },
+            {"MergerData", "ModularData", "TPCData"});
+
+        if(listOfCuts.size())
+        {
+            // Apply PID and save in file
+            auto gated {df.Filter(
+                [&](ActRoot::MergerData& m, ActRoot::ModularData& mod, ActRoot::TPCData& tpc)
+                {
+                    // L1
+                    if(lambdaIsL1(m, mod, tpc))
+                    {
+                        if(cuts.GetCut("l1"))
+                            return cuts.IsInside("l1", m.fLight.fRawTL, m.fLight.fQtotal);
+                        else
+                            return false;
+                    }
+                    // Noise in silicons
+                    else if(enableMatch && !lambdaMatch(m))
+                        return false;
+                    // One silicon
+                    else if(lambdaOne(m))
                     {
-                        // LIGHT particle
-                        auto l {cuts.IsInside(layer, m.fLight.fEs[0], m.fLight.fQave)};
-                        return l;
+                        auto layer {m.fLight.GetLayer(0)};
+                        if(cuts.GetCut(layer))
+                        {
+                            // LIGHT particle
+                            auto l {cuts.IsInside(layer, m.fLight.fEs[0], m.fLight.fQave)};
+                            return l;
+                        }
+                        else
+                            return false;
                     }
+                    else if(cuts.GetCut("f0-f1") && lambdaTwo(m)) // PID in fo-f1
+                        return cuts.IsInside("f0-f1", m.fLight.fEs[0], m.fLight.fEs[1]);
                     else
                         return false;
-                }
-                else if(cuts.GetCut("f0-f1") && lambdaTwo(m)) // PID in fo-f1
-                    return cuts.IsInside("f0-f1", m.fLight.fEs[0], m.fLight.fEs[1]);
-                else
-                    return false;
-            },
-            {"MergerData", "ModularData", "TPCData"})};
-        auto name {TString::Format("./Outputs/tree_pid_%s_%s_%s.root", beam.c_str(), target.c_str(), light.c_str())};
+                },
+                {"MergerData", "ModularData", "TPCData"})};
+            // Flat scalar columns only: later pipes do not need to deserialize MergerData
+            IOConfig::Snapshot(FlatColumns::Define(gated), "Pipe1_PID", "PID_Tree", ckpt.GetPartFile(run),
+                               FlatColumns::GetColumns());
+        }
+
+        // Accumulate this run and save the checkpoint
+        for(auto& [layer, h] : hsgas)
+            ckpt.Add("hGasSil_" + layer, *h.Merge());
+        for(auto& [layer, h] : hstwo)
+            ckpt.Add("hTwoSils_" + layer, *h.Merge());
+        ckpt.Add("hl1", *hl1.Merge());
+        ckpt.Add("hl1Gated", *hl1Gated.Merge());
+        ckpt.Add("hl1theta", *hl1theta.Merge());
+        ckpt.Add("hl1thetaCorr", *hl1thetaCorr.Merge());
+        ckpt.Commit(run);
+    }
+    for(const auto& key : liveKeys)
+        LiveServer::PublishTotal("Pipe1", key, ckpt.Get(key));
+
+    // All runs done: PID_Tree from the parts in run order
+    bool complete {true};
+    if(listOfCuts.size())
+    {
         std::cout << "Saving PID_Tree in file : " << name << '\n';
-        gated.Snapshot("PID_Tree", name.Data(), {"MergerData"});
+        complete = ckpt.Merge(name);
     }
+    if(complete)
+        ckpt.Clear();
 
     // Draw
     auto* c0 {new TCanvas {"c10", "Pipe 1 PID canvas 0"}};
     c0->DivideSquare(6);
     int p {1};
     c0->cd(1);
-    for(auto& [layer, h] : hsgas)
+    for(const auto& layer : {"f0", "l0", "r0"})
     {
         c0->cd(p);
-        h.Merge()->DrawClone("colz");
+        ckpt.Get(std::string {"hGasSil_"} + layer)->DrawClone("colz");
         cuts.DrawCut(layer);
         p++;
     }
-    for(auto& [layer, h] : hstwo)
+    for(const auto& layer : {"f0-f1"})
     {
         c0->cd(p);
-        h.Merge()->DrawClone("colz");
+        ckpt.Get(std::string {"hTwoSils_"} + layer)->DrawClone("colz");
         p++;
     }
     c0->cd(5);
-    hl1.Merge()->DrawClone("colz");
+    ckpt.Get("hl1")->DrawClone("colz");
     cuts.DrawCut("l1");
     c0->cd(6);
-    hl1theta.Merge()->DrawClone("colz");
+    ckpt.Get("hl1theta")->DrawClone("colz");
 
     auto* c2 {new TCanvas {"c12", "Pipe1 PID canvas 2"}};
     c2->DivideSquare(4);
+    // Slot 0 alone is not kept by the checkpoint: all runs and slots
     c2->cd(1);
-    hl1.GetAtSlot(0)->DrawClone("colz");
+    ckpt.Get("hl1")->DrawClone("colz");
     c2->cd(2);
-    hl1theta.GetAtSlot(0)->DrawClone("colz");
+    ckpt.Get("hl1theta")->DrawClone("colz");
     c2->cd(3);
-    hl1thetaCorr.Merge()->DrawClone("colz");
+    ckpt.Get("hl1thetaCorr")->DrawClone("colz");
     auto* gtheo {ActPhysics::Kinematics(TString::Format("%s(p,p)@110", beam.c_str()).Data()).GetTheta3vs4Line()};
     gtheo->SetLineColor(46);
     gtheo->Draw("l");
     c2->cd(4);
-    hl1Gated.Merge()->DrawClone("colz");
+    ckpt.Get("hl1Gated")->DrawClone("colz");
 }
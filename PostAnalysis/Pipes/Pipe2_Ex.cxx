@@ -3,7 +3,6 @@
 
 #include "ActCutsManager.h"
 #include "ActKinematics.h"
-#include "ActMergerData.h"
 #include "ActParticle.h"
 #include "ActSRIM.h"
 
@@ -27,14 +26,20 @@
 #include <string>
 #include <vector>
 
+#include "../FlatColumns.h"
 #include "../HistConfig.h"
+#include "../IOConfig.h"
+#include "../LiveServer.h"
+#include "../Sampling.h"
 
 void Pipe2_Ex(const std::string& beam, const std::string& target, const std::string& light)
 {
     // Read data
-    auto filename {TString::Format("./Outputs/tree_pid_%s_%s_%s.root", beam.c_str(), target.c_str(), light.c_str())};
+    auto filename {Sampling::GetInputFile(
+        TString::Format("./Outputs/tree_pid_%s_%s_%s.root", beam.c_str(), target.c_str(), light.c_str()).Data())};
     ROOT::EnableImplicitMT();
-    ROOT::RDataFrame df {"PID_Tree", filename};
+    // Quick-look sample of the runs (Runner with sample < 1)
+    auto df {Sampling::Filter(IOConfig::Read("PID_Tree", filename), "Run", "Entry")};
 
     // Init SRIM
     auto* srim {new ActPhysics::SRIM};
@@ -66,16 +71,16 @@ void Pipe2_Ex(const std::string& beam, const std::string& target, const std::str
 
     // Build energy at vertex
     auto dfVertex = df.Define("EVertex",
-                              [&](const ActRoot::MergerData& d)
+                              [&](unsigned char layer, float esil, float tl)
                               {
                                   double ret {};
-                                  if(d.fLight.IsFilled() && std::isfinite(d.fLight.fTL))
-                                      ret = srim->EvalInitialEnergy(light, d.fLight.fEs.front(), d.fLight.fTL);
-                                  else if(d.fLight.IsL1()) // L1 trigger
-                                      ret = srim->EvalEnergy(light, d.fLight.fTL);
+                                  if(FlatColumns::HasSil(layer) && std::isfinite(tl))
+                                      ret = srim->EvalInitialEnergy(light, esil, tl);
+                                  else if(layer == FlatColumns::kL1) // L1 trigger
+                                      ret = srim->EvalEnergy(light, tl);
                                   return ret;
                               },
-                              {"MergerData"});
+                              {"LayerCode", "ESil0", "TL"});
 
     // Init particles
     ActPhysics::Particle pb {beam};
@@ -111,66 +116,64 @@ void Pipe2_Ex(const std::string& beam, const std::string& target, const std::str
     auto def {
         dfVertex
             .Define("EBeam",
-                    [&](const ActRoot::MergerData& d)
+                    [&](int run, float rpx)
                     {
                         double EBeam {};
-                        if(EBeams.count(d.fRun))
-                            EBeam = EBeams[d.fRun];
+                        if(EBeams.count(run))
+                            EBeam = EBeams[run];
                         else
                             throw std::runtime_error("Defining EBeam: no initial beam energy for run " +
-                                                     std::to_string(d.fRun));
-                        return srim->Slow(beam, EBeam * pb.GetAMU(), d.fRP.X());
+                                                     std::to_string(run));
+                        return srim->Slow(beam, EBeam * pb.GetAMU(), rpx);
                     },
-                    {"MergerData"})
+                    {"Run", "RPx"})
             .DefineSlot("Rec_EBeam", // assuming Ex = 0 using outgoing light particle kinematics
-                        [&](unsigned int slot, double EVertex, const ActRoot::MergerData& d)
+                        [&](unsigned int slot, double EVertex, float thetaLight)
                         {
                             // no need for slots here but for the sake of consistency with next calculations...
-                            return vkins[slot].ReconstructBeamEnergyFromLabKinematics(EVertex, d.fThetaLight *
+                            return vkins[slot].ReconstructBeamEnergyFromLabKinematics(EVertex, thetaLight *
                                                                                                    TMath::DegToRad());
                         },
-                        {"EVertex", "MergerData"})
+                        {"EVertex", "ThetaLight"})
             .Define("ECM", [&](double EBeam) { return (mtarget / (mbeam + mtarget)) * EBeam; }, {"EBeam"})
             .Define("Rec_ECM", [&](double rec_EBeam) { return (mtarget / (mbeam + mtarget)) * rec_EBeam; },
                     {"Rec_EBeam"})
-            .Filter("fRP.fCoordinates.fX <= 200") // Mask decays by position... for 20Na; for 20Mg ~ 205 mm
+            .Filter("RPx <= 200") // Mask decays by position... for 20Na; for 20Mg ~ 205 mm
     };
 
     def =
         def.DefineSlot("Ex",
-                       [&](unsigned int slot, const ActRoot::MergerData& d, double EVertex, double EBeam)
+                       [&](unsigned int slot, float thetaLight, double EVertex, double EBeam)
                        {
                            vkins[slot].SetBeamEnergy(EBeam);
-                           return vkins[slot].ReconstructExcitationEnergy(EVertex, (d.fThetaLight) * TMath::DegToRad());
+                           return vkins[slot].ReconstructExcitationEnergy(EVertex, thetaLight * TMath::DegToRad());
                        },
-                       {"MergerData", "EVertex", "EBeam"})
+                       {"ThetaLight", "EVertex", "EBeam"})
             .DefineSlot("ThetaCM",
-                        [&](unsigned int slot, const ActRoot::MergerData& d, double EVertex, double EBeam)
+                        [&](unsigned int slot, float thetaLight, double EVertex, double EBeam)
                         {
                             vkins[slot].SetBeamEnergy(EBeam);
-                            return vkins[slot].ReconstructTheta3CMFromLab(EVertex,
-                                                                          (d.fThetaLight) * TMath::DegToRad()) *
+                            return vkins[slot].ReconstructTheta3CMFromLab(EVertex, thetaLight * TMath::DegToRad()) *
                                    TMath::RadToDeg();
                         },
-                        {"MergerData", "EVertex", "EBeam"});
+                        {"ThetaLight", "EVertex", "EBeam"});
 
     // Define range of heavy particle
-    def = def.Define("RangeHeavy", [&](ActRoot::MergerData& d) { return d.fRP.X() + d.fHeavy.fTL; }, {"MergerData"});
+    def = def.Define("RangeHeavy", [&](float rpx, float tl) { return rpx + tl; }, {"RPx", "HeavyTL"});
 
 
     // Create node to gate on different conditions: silicon layer, l1, etc
     // L0 trigger
-    auto nodel0 {def.Filter([](ActRoot::MergerData& d) { return d.fLight.IsL1() == false; }, {"MergerData"})};
+    auto nodel0 {def.Filter([](unsigned char layer) { return layer != FlatColumns::kL1; }, {"LayerCode"})};
     // L0 -> side silicons
-    auto nodeLat {nodel0.Filter([](ActRoot::MergerData& d)
-                                { return d.fLight.fLayers.front() == "l0" || d.fLight.fLayers.front() == "r0"; },
-                                {"MergerData"})};
+    auto nodeLat {nodel0.Filter([](unsigned char layer)
+                                { return layer == FlatColumns::kL0 || layer == FlatColumns::kR0; },
+                                {"LayerCode"})};
     // L0 -> front silicons
-    auto nodeFront {
-        nodel0.Filter([](ActRoot::MergerData& d) { return d.fLight.fLayers.front() == "f0"; }, {"MergerData"})};
+    auto nodeFront {nodel0.Filter([](unsigned char layer) { return layer == FlatColumns::kF0; }, {"LayerCode"})};
 
     // L1 trigger
-    auto nodel1 {def.Filter([](ActRoot::MergerData& d) { return d.fLight.IsL1() == true; }, {"MergerData"})};
+    auto nodel1 {def.Filter([](unsigned char layer) { return layer == FlatColumns::kL1; }, {"LayerCode"})};
 
     // Selection in Ep vs R20Mg plot
     auto nodeEpRSil {nodel0.Filter([&](float range, double elab) { return cuts.IsInside("ep_range", range, elab); },
@@ -183,20 +186,20 @@ void Pipe2_Ex(const std::string& beam, const std::string& target, const std::str
 
     // Combine nodes
     auto nodeL1GatedSil {def.Filter(
-        [&](ActRoot::MergerData& mer, float range, double elab)
+        [&](unsigned char layer, float range, double elab)
         {
-            if(mer.fLight.IsL1())
+            if(layer == FlatColumns::kL1)
                 return true;
             else
             {
                 return cuts.IsInside("ep_range", range, elab);
             }
         },
-        {"MergerData", "RangeHeavy", "EVertex"})};
+        {"LayerCode", "RangeHeavy", "EVertex"})};
 
 
     // Kinematics and Ex
-    auto hKin {def.Histo2D(HistConfig::KinEl, "fThetaLight", "EVertex")};
+    auto hKin {def.Histo2D(HistConfig::KinEl, "ThetaLight", "EVertex")};
     auto hKinCM {def.Histo2D(HistConfig::KinCM, "ThetaCM", "EVertex")};
 
     // Create vector of nodes and labels
@@ -243,7 +246,7 @@ void Pipe2_Ex(const std::string& beam, const std::string& target, const std::str
     std::vector<ROOT::RDF::RResultPtr<TH1D>> hsRPx;
     for(int i = 0; i < labels.size(); i++)
     {
-        auto h {nodes[i].Histo1D(HistConfig::RPx, "fRP.fCoordinates.fX")};
+        auto h {nodes[i].Histo1D(HistConfig::RPx, "RPx")};
         hsRPx.push_back(h);
     }
     // Rec_ECM
@@ -260,59 +263,69 @@ void Pipe2_Ex(const std::string& beam, const std::string& target, const std::str
         auto h {gatedNodes[i].Histo1D(HistConfig::ECM, "Rec_ECM")};
         hsGatedRecECM.push_back(h);
     }
-    auto hThetaBeam {def.Histo2D(HistConfig::ThetaBeam, "fRP.fCoordinates.fX", "fThetaBeam")};
-    auto hRP {def.Histo2D(HistConfig::RP, "fRP.fCoordinates.fX", "fRP.fCoordinates.fY")};
-    auto hThetaCMLab {def.Histo2D(HistConfig::ThetaCMLab, "fThetaLight", "ThetaCM")};
+    auto hThetaBeam {def.Histo2D(HistConfig::ThetaBeam, "RPx", "ThetaBeam")};
+    auto hRP {def.Histo2D(HistConfig::RP, "RPx", "RPy")};
+    auto hThetaCMLab {def.Histo2D(HistConfig::ThetaCMLab, "ThetaLight", "ThetaCM")};
     // Ex dependences
     auto hExThetaCM {def.Histo2D(HistConfig::ExThetaCM, "ThetaCM", "Ex")};
-    auto hExThetaLab {def.Histo2D(HistConfig::ExThetaLab, "fThetaLight", "Ex")};
-    auto hExRP {def.Histo2D(HistConfig::ExRPx, "fRP.fCoordinates.fX", "Ex")};
-    auto hExZ {nodel0.Histo2D(HistConfig::ExZ, "fSP.fCoordinates.fZ", "Ex")};
+    auto hExThetaLab {def.Histo2D(HistConfig::ExThetaLab, "ThetaLight", "Ex")};
+    auto hExRP {def.Histo2D(HistConfig::ExRPx, "RPx", "Ex")};
+    auto hExZ {nodel0.Histo2D(HistConfig::ExZ, "SPz", "Ex")};
     // Heavy histograms
     auto hThetaHLLab {def.Histo2D(HistConfig::ChangeTitle(HistConfig::ThetaHeavyLight, "Lab correlations"),
-                                  "fThetaLight", "fThetaHeavy")};
+                                  "ThetaLight", "ThetaHeavy")};
     auto hRecECM {def.Histo1D(HistConfig::ECM, "Rec_ECM")};
     hRecECM->SetTitle("Rec E_{CM} with E_{x} = 0");
 
     // Histograms for online analysis
     auto hRPxELab {
-        nodel1.Filter("70 < fThetaLight && fThetaLight < 80")
+        nodel1.Filter("70 < ThetaLight && ThetaLight < 80")
             .Histo2D({"hRPxELab", "#theta_{Lab} in [70, 80];RP.X [mm];E_{Vertex} [#circ]", 400, 0, 260, 300, 0, 30},
-                     "fRP.fCoordinates.fX", "EVertex")};
+                     "RPx", "EVertex")};
 
     auto hRPxThetaLab {
         nodel1.Histo2D({"hRPxThetaLab", "L1 exlusion zone;RP.X [mm];#theta_{Lab} [#circ]", 400, 0, 260, 300, 0, 90},
-                       "fRP.fCoordinates.fX", "fThetaLight")};
+                       "RPx", "ThetaLight")};
 
-    auto hECMRPx {nodeFront.Histo2D(HistConfig::RPxECM, "fRP.fCoordinates.fX", "ECM")};
-    auto hRecECMRPx {def.Histo2D(HistConfig::RPxECM, "fRP.fCoordinates.fX", "Rec_ECM")};
+    auto hECMRPx {nodeFront.Histo2D(HistConfig::RPxECM, "RPx", "ECM")};
+    auto hRecECMRPx {def.Histo2D(HistConfig::RPxECM, "RPx", "Rec_ECM")};
     auto hEpRMg {def.Histo2D(HistConfig::EpRMg, "RangeHeavy", "EVertex")};
     // ECM from cuts in Ep vs R20Mg histo
     auto hECMCutSil {nodeEpRSil.Histo1D(HistConfig::ECM, "ECM")};
     auto hECMCutFront {nodeEpFront.Histo1D(HistConfig::ECM, "ECM")};
     auto hECMCutSide {nodeEpSide.Histo1D(HistConfig::ECM, "ECM")};
 
+    // Live view while the event loop runs (Runner with a live port)
+    LiveServer::Publish("Pipe2", hKin);
+    LiveServer::Publish("Pipe2", hEpRMg);
+    LiveServer::Publish("Pipe2", hRP);
+    for(int i = 0; i < labels.size(); i++)
+    {
+        LiveServer::Publish("Pipe2", hsEx[i], "hEx_" + labels[i]);
+        LiveServer::Publish("Pipe2", hsECM[i], "hECM_" + labels[i]);
+    }
+
 
     // Save only the Ep_Range selection with silicons
-    auto outfile {TString::Format("./Outputs/tree_ex_%s_%s_%s.root", beam.c_str(), target.c_str(), light.c_str())};
-    nodeL1GatedSil.Snapshot("Final_Tree", outfile);
+    auto outfile {Sampling::GetFile(
+        TString::Format("./Outputs/tree_ex_%s_%s_%s.root", beam.c_str(), target.c_str(), light.c_str()).Data())};
+    // Columns and compression from configs/snapshot.conf
+    IOConfig::Snapshot(nodeL1GatedSil, "Pipe2_Ex", "Final_Tree", outfile);
     std::cout << "Saving Final_Tree in " << outfile << '\n';
 
     // std::ofstream streamer {"./debug_ep_range.dat"};
     // auto nodeStreamer {def.Filter([&](double e, float range) { return cuts.IsInside("debug_ep_range", range, e); },
     //                               {"EVertex", "RangeHeavy"})};
-    // auto hKinDebug {nodeStreamer.Histo2D(HistConfig::KinEl, "fThetaLight", "EVertex")};
+    // auto hKinDebug {nodeStreamer.Histo2D(HistConfig::KinEl, "ThetaLight", "EVertex")};
     // auto hCorrEDebug {
-    //     nodel0.Histo2D({"hDebug", ";TL;RP.X", 300, 0, 200, 300, 0, 200}, "RangeHeavy", "fRP.fCoordinates.fX")
-    // nodel0.Filter([](ActRoot::MergerData& m) { return m.fLight.IsL1() == false; }, {"MergerData"})
-    //     .Filter("120 <= RangeHeavy && RangeHeavy <= 140")
-    //     .Define("ESil", [](ActRoot::MergerData& m) { return m.fLight.fEs.front(); }, {"MergerData"})
+    //     nodel0.Histo2D({"hDebug", ";TL;RP.X", 300, 0, 200, 300, 0, 200}, "RangeHeavy", "RPx")
+    // nodel0.Filter("120 <= RangeHeavy && RangeHeavy <= 140")
     //     .Histo2D({"hDebug", "Debug ep range;#theta_{Lab} [#circ];E_{Sil} [MeV]", 300, 0, 100, 300, 0, 15},
-    //              "fThetaLight", "ESil")
-    // .Histo2D({"hECorr", "Check E sil rec;E_{Sil} [MeV];E_{Vertex} [MeV]", 300, 0, 15, 300, 0, 15}, "ESil",
+    //              "ThetaLight", "ESil0")
+    // .Histo2D({"hECorr", "Check E sil rec;E_{Sil} [MeV];E_{Vertex} [MeV]", 300, 0, 15, 300, 0, 15}, "ESil0",
     //          "EVertex")
     // };
-    // nodeStreamer.Foreach([&](ActRoot::MergerData& d) { d.Stream(streamer); }, {"MergerData"});
+    // nodeStreamer.Foreach([&](int run, int entry) { streamer << run << " " << entry << '\n'; }, {"Run", "Entry"});
     // streamer.close();
 
 
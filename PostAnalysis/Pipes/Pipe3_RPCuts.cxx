@@ -2,7 +2,6 @@
 #define PIPE3_RPCUTS_H
 #include "ActCutsManager.h"
 #include "ActKinematics.h"
-#include "ActMergerData.h"
 
 #include "ROOT/RDF/InterfaceUtils.hxx"
 #include "ROOT/RDF/RInterface.hxx"
@@ -22,12 +21,15 @@
 #include <vector>
 
 #include "../HistConfig.h"
+#include "../IOConfig.h"
+#include "../Sampling.h"
 
 void Pipe3_RPCuts(const std::string& beam, const std::string& target, const std::string& light)
 {
-    auto infile {TString::Format("./Outputs/tree_ex_%s_%s_%s.root", beam.c_str(), target.c_str(), light.c_str())};
+    auto infile {Sampling::GetInputFile(
+        TString::Format("./Outputs/tree_ex_%s_%s_%s.root", beam.c_str(), target.c_str(), light.c_str()).Data())};
     // ROOT::EnableImplicitMT();
-    ROOT::RDataFrame df {"Final_Tree", infile.Data()};
+    auto df {Sampling::Filter(IOConfig::Read("Final_Tree", infile), "Run", "Entry")};
 
 
     // Define intervals and histograms
@@ -65,20 +67,19 @@ void Pipe3_RPCuts(const std::string& beam, const std::string& target, const std:
 
     // Fill histograms
     df.Foreach(
-        [&](ActRoot::MergerData& mer, double elab, double ebeam, float range)
+        [&](float rpx, float thetaLight, double elab, double ebeam, float range)
         {
-            auto rpx {mer.fRP.X()};
             for(int i = 0; i < ivs.size(); i++)
             {
                 if(ivs[i].first <= rpx && rpx < ivs[i].second)
                 {
-                    hs[i].Get()->Fill(mer.fThetaLight, elab);
+                    hs[i].Get()->Fill(thetaLight, elab);
                     hsebeam[i].Get()->Fill(ebeam);
                     hsEpR[i].Get()->Fill(range, elab);
                 }
             }
         },
-        {"MergerData", "EVertex", "EBeam", "RangeHeavy"});
+        {"RPx", "ThetaLight", "EVertex", "EBeam", "RangeHeavy"});
 
     // Get kinematics
     std::vector<ActPhysics::Kinematics> kins;
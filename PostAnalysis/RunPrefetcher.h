@@ -0,0 +1,161 @@
+#ifndef RunPrefetcher_h
+#define RunPrefetcher_h
+
+#include "ROOT/RDF/InterfaceUtils.hxx"
+#include "ROOT/RDF/RSampleInfo.hxx"
+
+#include "TChain.h"
+#include "TFriendElement.h"
+#include "TSystem.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "./ChainUtils.h"
+
+// Reads ahead the files of the next runs (chain and all its friends) on a background thread while the
+// event loop processes the current one, so they are in the page cache when the loop reaches them
+// Runs are prefetched in processing order; the next run is always prefetched (double buffering) and further
+// ones only while the bytes ahead of the current run stay below the memory budget
+// The loop reports its position with Notify(), directly from a run-by-run loop or per sample through Attach()
+class RunPrefetcher
+{
+private:
+    struct Run
+    {
+        int fRun {};
+        std::vector<std::string> fFiles;
+        Long64_t fSize {};
+    };
+    std::vector<Run> fRuns;
+    Long64_t fBudget {};
+    std::thread fThread;
+    std::mutex fMutex;
+    std::condition_variable fCV;
+    int fCurrent {}; //!< Index in fRuns of the latest run reached by the event loop
+    std::atomic<bool> fStop {false};
+
+public:
+    // runs: the ones to prefetch and their processing order (ex: pending runs of a Checkpoint); empty = all,
+    // in chain order
+    RunPrefetcher(TChain* chain, const std::vector<int>& runs = {}, double budgetMB = 2048)
+        : fBudget(static_cast<Long64_t>(budgetMB * 1024 * 1024))
+    {
+        // Group the files of the chain and its friends by run
+        std::vector<TChain*> chains {chain};
+        if(auto* friends {chain->GetListOfFriends()}; friends)
+            for(auto* obj : *friends)
+                if(auto* fr {dynamic_cast<TChain*>(static_cast<TFriendElement*>(obj)->GetTree())}; fr)
+                    chains.push_back(fr);
+        std::map<int, int> idx;
+        for(auto* c : chains)
+            for(const auto& file : ChainUtils::GetFiles(c))
+            {
+                auto run {ChainUtils::GetRun(file)};
+                if(runs.size() && std::find(runs.begin(), runs.end(), run) == runs.end())
+                    continue;
+                if(!idx.count(run))
+                {
+                    idx[run] = fRuns.size();
+                    fRuns.push_back({run});
+                }
+                auto& r {fRuns[idx[run]]};
+                r.fFiles.push_back(file);
+                FileStat_t stat;
+                if(gSystem->GetPathInfo(file.c_str(), stat) == 0)
+                    r.fSize += stat.fSize;
+            }
+        if(runs.size())
+            std::stable_sort(fRuns.begin(), fRuns.end(),
+                             [&](const Run& a, const Run& b)
+                             {
+                                 return std::find(runs.begin(), runs.end(), a.fRun) <
+                                        std::find(runs.begin(), runs.end(), b.fRun);
+                             });
+        fThread = std::thread {[this] { Loop(); }};
+    }
+    ~RunPrefetcher()
+    {
+        fStop = true;
+        fCV.notify_all();
+        if(fThread.joinable())
+            fThread.join();
+    }
+    RunPrefetcher(const RunPrefetcher&) = delete;
+    RunPrefetcher& operator=(const RunPrefetcher&) = delete;
+
+    // Called when the processing of run starts
+    int Notify(int run)
+    {
+        auto it {std::find_if(fRuns.begin(), fRuns.end(), [&](const Run& r) { return r.fRun == run; })};
+        if(it != fRuns.end())
+        {
+            std::lock_guard<std::mutex> lock {fMutex};
+            fCurrent = std::max(fCurrent, static_cast<int>(it - fRuns.begin()));
+        }
+        fCV.notify_all();
+        return run;
+    }
+
+    // For a single loop over the whole chain: reports each new sample (file) to the prefetcher
+    // Per-sample callbacks run at the start of each sample whether the column is read or not, so no node
+    // is added to the per-event path
+    ROOT::RDF::RNode Attach(ROOT::RDF::RNode df)
+    {
+        return df.DefinePerSample("PrefetchRun", [this](unsigned int, const ROOT::RDF::RSampleInfo& id)
+                                  { return Notify(ChainUtils::GetRun(id.AsString())); });
+    }
+
+private:
+    void Loop()
+    {
+        for(int next = 0; next < static_cast<int>(fRuns.size()); next++)
+        {
+            {
+                std::unique_lock<std::mutex> lock {fMutex};
+                fCV.wait(lock,
+                         [&]
+                         {
+                             if(fStop || next <= fCurrent + 1)
+                                 return true;
+                             Long64_t ahead {};
+                             for(int i = fCurrent + 1; i <= next; i++)
+                                 ahead += fRuns[i].fSize;
+                             return ahead <= fBudget;
+                         });
+                if(fStop)
+                    return;
+                // Already processed: nothing to gain
+                if(next < fCurrent)
+                    continue;
+            }
+            for(const auto& file : fRuns[next].fFiles)
+                Warm(file);
+        }
+    }
+
+    // Read the whole file once so that it sits in the page cache (also for network mounts)
+    void Warm(const std::string& file)
+    {
+        auto fd {::open(file.c_str(), O_RDONLY)};
+        if(fd < 0)
+            return;
+        ::posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+        std::vector<char> buffer(8 * 1024 * 1024);
+        while(!fStop && ::read(fd, buffer.data(), buffer.size()) > 0)
+        {
+        }
+        ::close(fd);
+    }
+};
+
+#endif
@@ -2,11 +2,18 @@
 
 #include "TROOT.h"
 #include "TString.h"
+#include "TSystem.h"
 
+#include <algorithm>
 #include <iostream>
 #include <string>
 
-void Runner(TString what = "")
+#include "./IOConfig.h"
+#include "./LiveServer.h"
+#include "./Sampling.h"
+
+void Runner(TString what = "", bool rntuple = false, TString exportFmt = "", int livePort = 0,
+            double sample = 1, TString profile = "")
 {
     std::string beam {"20Na"};
     std::string target {"p"};
@@ -17,38 +24,66 @@ void Runner(TString what = "")
     std::cout << "-> Target : " << target << '\n';
     std::cout << "-> Light  : " << light << '\n';
     std::cout << "-> What   : " << what << '\n';
+    std::cout << "-> Format : " << (rntuple ? "RNTuple" : "TTree") << '\n';
+    std::cout << "-> Snap   : " << (profile.Length() ? profile : "from snapshot.conf") << '\n';
+    std::cout << "-> Export : " << (exportFmt.Length() ? exportFmt : "none") << '\n';
+    std::cout << "-> Sample : " << (sample < 1 ? TString::Format("%g%% and refining", 100 * sample) : "all") << '\n';
+    std::cout << "-> Live   : " << (livePort > 0 ? TString::Format("http://localhost:%d", livePort) : "off") << '\n';
     std::cout << "······························" << RESET << '\n';
 
+    // Output format of pipe snapshots; readers detect it
+    IOConfig::UseRNTuple() = rntuple;
+    // Compression profile of pipe snapshots: default, fast or archive
+    IOConfig::Profile() = profile.Data();
+    // Partial histograms served over http while pipes run
+    LiveServer::Port() = livePort;
+
     auto args {TString::Format("(\"%s\", \"%s\", \"%s\")", beam.c_str(), target.c_str(), light.c_str())};
     TString path {"./Pipes/"};
     TString func {};
     TString ext {".cxx"};
 
-    // CFA counter
-    if(what.Contains("0"))
-    {
-        func = "Pipe0_Beam";
-        gROOT->LoadMacro(path + func + ext);
-        gROOT->ProcessLine(func + "()");
-    }
-    // PID
-    if(what.Contains("1"))
-    {
-        func = "Pipe1_PID";
-        gROOT->LoadMacro(path + func + ext);
-        gROOT->ProcessLine(func + args);
-    }
-    // Kin + Ex
-    if(what.Contains("2"))
-    {
-        func = "Pipe2_Ex";
-        gROOT->LoadMacro(path + func + ext);
-        gROOT->ProcessLine(func + args);
-    }
-    if(what.Contains("3"))
+    // Quick look: run on a sample of the events and refine x10 per pass up to the full dataset
+    // Spectra of each pass are scaled to full statistics; the last pass is the usual full run
+    for(double fraction = (sample > 0 ? std::min(sample, 1.) : 1.);; fraction = std::min(10 * fraction, 1.))
     {
-        func = "Pipe3_RPCuts";
-        gROOT->LoadMacro(path + func + ext);
-        gROOT->ProcessLine(func + args);
+        Sampling::Fraction() = fraction;
+        if(Sampling::IsEnabled())
+            std::cout << BOLDCYAN << "-> Sampling " << 100 * fraction << "% of events" << RESET << '\n';
+        // CFA counter
+        if(what.Contains("0"))
+        {
+            func = "Pipe0_Beam";
+            gROOT->LoadMacro(path + func + ext);
+            gROOT->ProcessLine(func + "()");
+        }
+        // PID
+        if(what.Contains("1"))
+        {
+            func = "Pipe1_PID";
+            gROOT->LoadMacro(path + func + ext);
+            gROOT->ProcessLine(func + args);
+        }
+        // Kin + Ex
+        if(what.Contains("2"))
+        {
+            func = "Pipe2_Ex";
+            gROOT->LoadMacro(path + func + ext);
+            gROOT->ProcessLine(func + args);
+            // Columnar copy of Final_Tree for non-ROOT users: "arrow" (IPC) or "parquet"
+            if(exportFmt.Length() && !Sampling::IsEnabled())
+                gSystem->Exec(
+                    TString::Format("python3 ./exportArrow.py ./Outputs/tree_ex_%s_%s_%s.root --format %s",
+                                    beam.c_str(), target.c_str(), light.c_str(), exportFmt.Data()));
+        }
+        if(what.Contains("3"))
+        {
+            func = "Pipe3_RPCuts";
+            gROOT->LoadMacro(path + func + ext);
+            gROOT->ProcessLine(func + args);
+        }
+        Sampling::ScaleCanvases();
+        if(!Sampling::IsEnabled())
+            break;
     }
 }
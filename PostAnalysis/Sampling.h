@@ -0,0 +1,112 @@
+#ifndef Sampling_h
+#define Sampling_h
+
+#include "ROOT/RDF/InterfaceUtils.hxx"
+
+#include "TCanvas.h"
+#include "TH1.h"
+#include "THStack.h"
+#include "TList.h"
+#include "TROOT.h"
+#include "TString.h"
+#include "TSystem.h"
+
+#include <cstdint>
+#include <string>
+
+// Quick-look mode: pipes process a deterministic uniform sample of (run, entry) over all runs
+// The draw of each event depends only on its (run, entry), so a 1% sample is contained in the 10% one
+// and re-sampling an already sampled output is a no-op; Runner refines the fraction pass after pass
+// Sampled outputs get a suffix so they never overwrite the full ones
+namespace Sampling
+{
+// Fraction of events processed, 1 = all; set by Runner
+inline double& Fraction()
+{
+    static double ret {1};
+    return ret;
+}
+inline bool IsEnabled()
+{
+    return Fraction() < 1;
+}
+
+// Uniform in [0, 1) from (run, entry), splitmix64 finalizer
+inline double Uniform(int run, Long64_t entry)
+{
+    std::uint64_t x {(static_cast<std::uint64_t>(run) << 40) ^ static_cast<std::uint64_t>(entry)};
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    x ^= x >> 31;
+    return static_cast<double>(x >> 11) * 0x1.0p-53;
+}
+
+// Keep the sampled events; call it first so no other column is read for the rejected ones
+inline ROOT::RDF::RNode Filter(ROOT::RDF::RNode df, const std::string& runCol, const std::string& entryCol)
+{
+    if(!IsEnabled())
+        return df;
+    auto fraction {Fraction()};
+    return df.Filter([fraction](int run, int entry) { return Uniform(run, entry) < fraction; }, {runCol, entryCol});
+}
+
+// Tag of sampled outputs, empty for the full dataset
+inline std::string GetSuffix()
+{
+    return IsEnabled() ? TString::Format("_sample%g", Fraction()).Data() : "";
+}
+// ./Outputs/tree_pid_X.root -> ./Outputs/tree_pid_X_sample0.01.root when sampling
+inline std::string GetFile(const std::string& file)
+{
+    auto ret {file};
+    ret.insert(ret.rfind(".root"), GetSuffix());
+    return ret;
+}
+// Sampled output of the previous pipe if present, the full one otherwise (Filter subsamples it)
+inline std::string GetInputFile(const std::string& file)
+{
+    auto ret {GetFile(file)};
+    return gSystem->AccessPathName(ret.c_str()) ? file : ret;
+}
+
+// Scale to the full statistics the histograms drawn in pad and its subpads
+inline void ScalePad(TVirtualPad* pad, double scale)
+{
+    for(auto* obj : *pad->GetListOfPrimitives())
+    {
+        if(auto* sub {dynamic_cast<TVirtualPad*>(obj)}; sub)
+            ScalePad(sub, scale);
+        else if(auto* stack {dynamic_cast<THStack*>(obj)}; stack && stack->GetHists())
+            for(auto* h : *stack->GetHists())
+                static_cast<TH1*>(h)->Scale(scale);
+        else if(auto* h {dynamic_cast<TH1*>(obj)}; h)
+        {
+            if(h->GetSumw2N() == 0)
+                h->Sumw2();
+            h->Scale(scale);
+        }
+    }
+    pad->Modified();
+}
+
+// Scale the canvases drawn by the last pass (marked in the title so they are scaled once) and refresh them
+inline void ScaleCanvases()
+{
+    if(!IsEnabled())
+        return;
+    TString mark {TString::Format(" [%g%% sample]", 100 * Fraction())};
+    for(auto* obj : *gROOT->GetListOfCanvases())
+    {
+        auto* c {static_cast<TCanvas*>(obj)};
+        if(TString {c->GetTitle()}.Contains("% sample]"))
+            continue;
+        ScalePad(c, 1. / Fraction());
+        c->SetTitle(TString {c->GetTitle()} + mark);
+        c->Update();
+    }
+    gSystem->ProcessEvents();
+}
+} // namespace Sampling
+
+#endif
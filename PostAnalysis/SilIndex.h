@@ -0,0 +1,151 @@
+#ifndef SilIndex_h
+#define SilIndex_h
+
+#include "ActInputParser.h"
+
+#include "Math/Point3D.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Uniform grid over the (X or Y, Z) plane of each silicon layer in silspecs.conf
+// Matching a SP to a pad is a single cell lookup plus a check of the few pads overlapping the cell
+class SilIndex
+{
+private:
+    struct Pad
+    {
+        int fIdx {};
+        double fUMin {};
+        double fUMax {};
+        double fZMin {};
+        double fZMax {};
+    };
+    struct Layer
+    {
+        bool fAlongX {};  //!< Layer perpendicular to X: SP coordinate is Y; otherwise X
+        double fUMin {};
+        double fZMin {};
+        int fNu {};
+        int fNz {};
+        std::vector<Pad> fPads;
+        std::vector<std::vector<int>> fCells; //!< Positions in fPads overlapping each cell
+    };
+    std::map<std::string, Layer> fLayers;
+    double fCell {};
+    bool fUseZ {};
+
+public:
+    SilIndex(const std::string& file, const std::vector<std::string>& layers, bool useZ = false, double cell = 5)
+        : fCell(cell),
+          fUseZ(useZ)
+    {
+        ActRoot::InputParser parser {file};
+        for(const auto& name : layers)
+            Build(name, parser.GetBlock(name));
+    }
+
+    // Returns silicon index hit by (u, z) in layer, -1 if none
+    // Without Z, the first pad of the column is returned
+    int Find(const std::string& layer, double u, double z) const
+    {
+        int ret {-1};
+        Visit(layer, u, z,
+              [&](int idx)
+              {
+                  ret = idx;
+                  return true;
+              });
+        return ret;
+    }
+    // Geometric validation of silicon index n with (u, z)
+    bool IsMatch(const std::string& layer, int n, double u, double z) const
+    {
+        return Visit(layer, u, z, [&](int idx) { return idx == n; });
+    }
+    // Same with SP in physical units; picks coordinate according to layer orientation
+    template <typename T>
+    bool IsMatch(const std::string& layer, int n, const ROOT::Math::PositionVector3D<T>& sp) const
+    {
+        auto it {fLayers.find(layer)};
+        if(it == fLayers.end())
+            return false;
+        return IsMatch(layer, n, it->second.fAlongX ? sp.Y() : sp.X(), sp.Z());
+    }
+
+private:
+    // Calls func(index) for pads containing (u, z) until it returns true
+    template <typename F>
+    bool Visit(const std::string& layer, double u, double z, F&& func) const
+    {
+        auto it {fLayers.find(layer)};
+        if(it == fLayers.end())
+            return false;
+        const auto& l {it->second};
+        auto iu {static_cast<int>(std::floor((u - l.fUMin) / fCell))};
+        auto iz {fUseZ ? static_cast<int>(std::floor((z - l.fZMin) / fCell)) : 0};
+        if(iu < 0 || iu >= l.fNu || iz < 0 || iz >= l.fNz)
+            return false;
+        for(auto p : l.fCells[iu * l.fNz + iz])
+        {
+            const auto& pad {l.fPads[p]};
+            if(pad.fUMin <= u && u <= pad.fUMax && (!fUseZ || (pad.fZMin <= z && z <= pad.fZMax)))
+                if(func(pad.fIdx))
+                    return true;
+        }
+        return false;
+    }
+
+    void Build(const std::string& name, std::shared_ptr<ActRoot::InputBlock> block)
+    {
+        Layer l;
+        auto width {block->GetDouble("Width")};
+        auto height {block->GetDouble("Height")};
+        double margin {};
+        if(block->CheckTokenExists("MatchMargin"))
+            margin = block->GetDouble("MatchMargin");
+        auto normal {block->GetDoubleVector("Normal")};
+        l.fAlongX = std::abs(normal.at(0)) > 0.5;
+        // Pads declared as iX: u, z
+        for(int i = 0; i < 64; i++)
+        {
+            auto token {"i" + std::to_string(i)};
+            if(!block->CheckTokenExists(token))
+                continue;
+            auto c {block->GetDoubleVector(token)};
+            l.fPads.push_back({i, c.at(0) - width / 2 - margin, c.at(0) + width / 2 + margin,
+                               c.at(1) - height / 2 - margin, c.at(1) + height / 2 + margin});
+        }
+        if(l.fPads.empty())
+            return;
+        l.fUMin = std::min_element(l.fPads.begin(), l.fPads.end(), [](auto& a, auto& b) { return a.fUMin < b.fUMin; })
+                      ->fUMin;
+        auto umax {std::max_element(l.fPads.begin(), l.fPads.end(), [](auto& a, auto& b) { return a.fUMax < b.fUMax; })
+                       ->fUMax};
+        l.fZMin = std::min_element(l.fPads.begin(), l.fPads.end(), [](auto& a, auto& b) { return a.fZMin < b.fZMin; })
+                      ->fZMin;
+        auto zmax {std::max_element(l.fPads.begin(), l.fPads.end(), [](auto& a, auto& b) { return a.fZMax < b.fZMax; })
+                       ->fZMax};
+        l.fNu = static_cast<int>(std::ceil((umax - l.fUMin) / fCell));
+        l.fNz = fUseZ ? static_cast<int>(std::ceil((zmax - l.fZMin) / fCell)) : 1;
+        l.fCells.resize(l.fNu * l.fNz);
+        for(int p = 0; p < static_cast<int>(l.fPads.size()); p++)
+        {
+            const auto& pad {l.fPads[p]};
+            auto u0 {static_cast<int>(std::floor((pad.fUMin - l.fUMin) / fCell))};
+            auto u1 {std::min(l.fNu - 1, static_cast<int>(std::floor((pad.fUMax - l.fUMin) / fCell)))};
+            auto z0 {fUseZ ? static_cast<int>(std::floor((pad.fZMin - l.fZMin) / fCell)) : 0};
+            auto z1 {fUseZ ? std::min(l.fNz - 1, static_cast<int>(std::floor((pad.fZMax - l.fZMin) / fCell))) : 0};
+            for(int iu = u0; iu <= u1; iu++)
+                for(int iz = z0; iz <= z1; iz++)
+                    l.fCells[iu * l.fNz + iz].push_back(p);
+        }
+        fLayers[name] = l;
+    }
+};
+
+#endif
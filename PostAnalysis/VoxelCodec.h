@@ -0,0 +1,291 @@
+#ifndef VoxelCodec_h
+#define VoxelCodec_h
+
+#include "ActCluster.h"
+#include "ActTPCData.h"
+#include "ActVoxel.h"
+
+#include "ROOT/RDF/InterfaceUtils.hxx"
+#include "ROOT/RVec.hxx"
+
+#include "TFile.h"
+#include "TList.h"
+#include "TNamed.h"
+#include "TString.h"
+#include "TTree.h"
+
+#include "Math/Point3D.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+// Compact on-disk encoding of TPCData voxels, written by runCompactVoxels.cxx
+// to RootFiles/Compact/Compact_Run_XXXX.root (CompactTree, entry-aligned with Filter)
+// Per cluster, voxels are sorted in (X, Y, Z) and X, Y stored as int16 deltas from the previous one (pads);
+// Z (rebinned time buckets, not integers) is quantized in units of fZPrecision as int16 relative to the first voxel
+// of the cluster, whose Z is stored as float; offsets beyond the int16 range are clamped (counted in fNZClamped)
+// Charge is quantized in units of fQPrecision and saturates at 65535 (counted in fNSaturated)
+// Lines (point, direction, chi2) are stored as written by the filter, so FindRP corrections are kept
+// Flags: bit 0 is BeamLike, bit i + 1 the i-th name of the flag table stored in the tree UserInfo
+namespace VoxelCodec
+{
+constexpr std::uint32_t kBeamLike {1u << 0};
+
+// Cluster flags set by the filter actions of this repo: RecRANSAC, TagPileUp and the EventClassifier
+// classes declared in its model file (configs/user/Models/event_classifier.txt)
+inline std::vector<std::string> GetFlagNames(const std::string& model)
+{
+    std::vector<std::string> ret {"IsRANSAC", "IsPileUp"};
+    std::ifstream streamer {model};
+    if(!streamer)
+        throw std::runtime_error("VoxelCodec::GetFlagNames(): could not open " + model);
+    std::string line;
+    while(std::getline(streamer, line))
+    {
+        if(line.rfind("# classes:", 0) != 0)
+            continue;
+        std::istringstream iss {line.substr(line.find(':') + 1)};
+        std::string label;
+        while(std::getline(iss, label, ','))
+        {
+            label.erase(0, label.find_first_not_of(' '));
+            label.erase(label.find_last_not_of(' ') + 1);
+            if(label.size())
+                ret.push_back("Class" + label);
+        }
+    }
+    return ret;
+}
+
+// Flag table stored with the tree, as a comma separated list
+inline void WriteFlagNames(TTree* tree, const std::vector<std::string>& names)
+{
+    TString list;
+    for(const auto& name : names)
+        list += (list.Length() ? "," : "") + TString {name};
+    tree->GetUserInfo()->Add(new TNamed {"VoxFlagNames", list.Data()});
+}
+inline std::vector<std::string> ReadFlagNames(const std::string& file, const std::string& tree = "CompactTree")
+{
+    std::vector<std::string> ret;
+    auto f {std::unique_ptr<TFile>(TFile::Open(file.c_str()))};
+    if(!f)
+        return ret;
+    auto* t {f->Get<TTree>(tree.c_str())};
+    if(!t)
+        return ret;
+    auto* names {dynamic_cast<TNamed*>(t->GetUserInfo()->FindObject("VoxFlagNames"))};
+    if(!names)
+        return ret;
+    std::istringstream iss {names->GetTitle()};
+    std::string name;
+    while(std::getline(iss, name, ','))
+        ret.push_back(name);
+    return ret;
+}
+
+struct Data
+{
+    double fQPrecision {1};
+    double fZPrecision {0.01};
+    std::vector<std::string> fFlagNames {}; //!< From GetFlagNames, not written per entry
+    long fNSaturated {};                    //!< Voxels whose charge saturated, not written
+    long fNZClamped {};                     //!< Voxels whose Z offset was clamped, not written
+    std::vector<int> fNVoxels;              //!< Per cluster
+    std::vector<std::uint32_t> fFlags;      //!< Per cluster
+    std::vector<float> fPx, fPy, fPz;       //!< Line point, per cluster
+    std::vector<float> fDx, fDy, fDz;       //!< Line direction, per cluster
+    std::vector<float> fChi2;               //!< Per cluster
+    std::vector<std::int16_t> fXY;          //!< 2 deltas per voxel
+    std::vector<float> fZ0;                 //!< Z of the first voxel, per cluster
+    std::vector<std::int16_t> fZ;           //!< Z - Z0 in units of fZPrecision, per voxel
+    std::vector<std::uint16_t> fQ;          //!< Per voxel
+    std::vector<float> fRPx, fRPy, fRPz;
+
+    void SetBranches(TTree* tree)
+    {
+        if(fFlagNames.empty())
+            throw std::runtime_error("VoxelCodec::Data::SetBranches(): no cluster flags, set them with GetFlagNames");
+        if(fFlagNames.size() > 31)
+            throw std::runtime_error("VoxelCodec::Data::SetBranches(): more than 31 cluster flags");
+        tree->Branch("VoxQPrecision", &fQPrecision);
+        tree->Branch("VoxZPrecision", &fZPrecision);
+        tree->Branch("VoxN", &fNVoxels);
+        tree->Branch("VoxFlags", &fFlags);
+        tree->Branch("VoxPx", &fPx);
+        tree->Branch("VoxPy", &fPy);
+        tree->Branch("VoxPz", &fPz);
+        tree->Branch("VoxDx", &fDx);
+        tree->Branch("VoxDy", &fDy);
+        tree->Branch("VoxDz", &fDz);
+        tree->Branch("VoxChi2", &fChi2);
+        tree->Branch("VoxXY", &fXY);
+        tree->Branch("VoxZ0", &fZ0);
+        tree->Branch("VoxZ", &fZ);
+        tree->Branch("VoxQ", &fQ);
+        tree->Branch("VoxRPx", &fRPx);
+        tree->Branch("VoxRPy", &fRPy);
+        tree->Branch("VoxRPz", &fRPz);
+        WriteFlagNames(tree, fFlagNames);
+    }
+
+    void Encode(const ActRoot::TPCData& tpc)
+    {
+        for(auto* v : {&fPx, &fPy, &fPz, &fDx, &fDy, &fDz, &fChi2, &fZ0, &fRPx, &fRPy, &fRPz})
+            v->clear();
+        fNVoxels.clear();
+        fFlags.clear();
+        fXY.clear();
+        fZ.clear();
+        fQ.clear();
+        struct Vox
+        {
+            int fX, fY;
+            float fZ;
+            int fQ;
+            bool operator<(const Vox& o) const { return std::tie(fX, fY, fZ) < std::tie(o.fX, o.fY, o.fZ); }
+        };
+        std::vector<Vox> buf;
+        for(const auto& cl : tpc.fClusters)
+        {
+            buf.clear();
+            for(const auto& v : cl.GetRefToVoxels())
+            {
+                const auto& p {v.GetPosition()};
+                auto q {std::lround(v.GetCharge() / fQPrecision)};
+                if(q > std::numeric_limits<std::uint16_t>::max())
+                    fNSaturated++;
+                buf.push_back({static_cast<int>(std::lround(p.X())), static_cast<int>(std::lround(p.Y())),
+                               static_cast<float>(p.Z()),
+                               static_cast<int>(std::clamp<long>(q, 0, std::numeric_limits<std::uint16_t>::max()))});
+            }
+            std::sort(buf.begin(), buf.end());
+            std::array<int, 2> prev {};
+            auto z0 {buf.size() ? buf.front().fZ : 0.f};
+            for(const auto& v : buf)
+            {
+                fXY.push_back(static_cast<std::int16_t>(v.fX - prev[0]));
+                fXY.push_back(static_cast<std::int16_t>(v.fY - prev[1]));
+                prev = {v.fX, v.fY};
+                auto dz {std::lround((v.fZ - z0) / fZPrecision)};
+                if(dz < std::numeric_limits<std::int16_t>::min() || dz > std::numeric_limits<std::int16_t>::max())
+                    fNZClamped++;
+                fZ.push_back(static_cast<std::int16_t>(std::clamp<long>(dz, std::numeric_limits<std::int16_t>::min(),
+                                                                        std::numeric_limits<std::int16_t>::max())));
+                fQ.push_back(static_cast<std::uint16_t>(v.fQ));
+            }
+            fNVoxels.push_back(buf.size());
+            fZ0.push_back(z0);
+            // Line as stored by the filter
+            const auto& line {cl.GetLine()};
+            auto p {line.GetPoint()};
+            auto d {line.GetDirection()};
+            fPx.push_back(p.X());
+            fPy.push_back(p.Y());
+            fPz.push_back(p.Z());
+            fDx.push_back(d.X());
+            fDy.push_back(d.Y());
+            fDz.push_back(d.Z());
+            fChi2.push_back(line.GetChi2());
+            // Flags
+            std::uint32_t flags {};
+            if(cl.GetIsBeamLike())
+                flags |= kBeamLike;
+            for(int i = 0; i < static_cast<int>(fFlagNames.size()); i++)
+                if(cl.GetFlag(fFlagNames[i]))
+                    flags |= 1u << (i + 1);
+            fFlags.push_back(flags);
+        }
+        for(const auto& rp : tpc.fRPs)
+        {
+            fRPx.push_back(rp.X());
+            fRPy.push_back(rp.Y());
+            fRPz.push_back(rp.Z());
+        }
+    }
+};
+
+// Decoded columns of one entry
+struct Columns
+{
+    const ROOT::RVecI& fNVoxels;
+    const ROOT::RVec<std::uint32_t>& fFlags;
+    const ROOT::RVecF &fPx, &fPy, &fPz, &fDx, &fDy, &fDz, &fChi2;
+    const ROOT::RVec<std::int16_t>& fXY;
+    const ROOT::RVecF& fZ0;
+    const ROOT::RVec<std::int16_t>& fZ;
+    const ROOT::RVec<std::uint16_t>& fQ;
+    const ROOT::RVecF &fRPx, &fRPy, &fRPz;
+};
+
+// Rebuild TPCData from the compact columns, with the stored lines and flags (names from ReadFlagNames)
+inline ActRoot::TPCData
+Decode(const Columns& c, double qPrecision, double zPrecision, const std::vector<std::string>& flagNames)
+{
+    ActRoot::TPCData ret;
+    int iv {};
+    for(int k = 0; k < static_cast<int>(c.fNVoxels.size()); k++)
+    {
+        std::vector<ActRoot::Voxel> voxels(c.fNVoxels[k]);
+        std::array<int, 2> pos {};
+        for(auto& v : voxels)
+        {
+            pos[0] += c.fXY[2 * iv];
+            pos[1] += c.fXY[2 * iv + 1];
+            v.SetPosition({static_cast<float>(pos[0]), static_cast<float>(pos[1]),
+                           static_cast<float>(c.fZ0[k] + c.fZ[iv] * zPrecision)});
+            v.SetCharge(c.fQ[iv] * qPrecision);
+            iv++;
+        }
+        ActRoot::Cluster cl {k};
+        cl.SetVoxels(std::move(voxels));
+        cl.ReFillSets();
+        auto& line {cl.GetRefToLine()};
+        line.SetPoint({c.fPx[k], c.fPy[k], c.fPz[k]});
+        line.SetDirection({c.fDx[k], c.fDy[k], c.fDz[k]});
+        line.SetChi2(c.fChi2[k]);
+        cl.SetBeamLike(c.fFlags[k] & kBeamLike);
+        for(int i = 0; i < static_cast<int>(flagNames.size()); i++)
+            if(c.fFlags[k] & (1u << (i + 1)))
+                cl.SetFlag(flagNames[i], true);
+        ret.fClusters.push_back(std::move(cl));
+    }
+    for(int r = 0; r < static_cast<int>(c.fRPx.size()); r++)
+        ret.fRPs.push_back({c.fRPx[r], c.fRPy[r], c.fRPz[r]});
+    return ret;
+}
+
+// Defines a TPCData column from a CompactTree friend, so existing lambdas run unchanged
+// flagNames: ReadFlagNames() of any file of the chain
+inline ROOT::RDF::RNode
+DefineTPCData(ROOT::RDF::RNode df, const std::vector<std::string>& flagNames, const std::string& name = "TPCData")
+{
+    return df.Define(name,
+                     [flagNames](double qPrecision, double zPrecision, const ROOT::RVecI& n,
+                                 const ROOT::RVec<std::uint32_t>& f, const ROOT::RVecF& px, const ROOT::RVecF& py,
+                                 const ROOT::RVecF& pz, const ROOT::RVecF& dx, const ROOT::RVecF& dy,
+                                 const ROOT::RVecF& dz, const ROOT::RVecF& chi2, const ROOT::RVec<std::int16_t>& xy,
+                                 const ROOT::RVecF& z0, const ROOT::RVec<std::int16_t>& z,
+                                 const ROOT::RVec<std::uint16_t>& q, const ROOT::RVecF& rpx, const ROOT::RVecF& rpy,
+                                 const ROOT::RVecF& rpz)
+                     {
+                         return Decode({n, f, px, py, pz, dx, dy, dz, chi2, xy, z0, z, q, rpx, rpy, rpz}, qPrecision,
+                                       zPrecision, flagNames);
+                     },
+                     {"VoxQPrecision", "VoxZPrecision", "VoxN", "VoxFlags", "VoxPx", "VoxPy", "VoxPz", "VoxDx",
+                      "VoxDy", "VoxDz", "VoxChi2", "VoxXY", "VoxZ0", "VoxZ", "VoxQ", "VoxRPx", "VoxRPy", "VoxRPz"});
+}
+} // namespace VoxelCodec
+
+#endif
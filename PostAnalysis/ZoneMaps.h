@@ -0,0 +1,231 @@
+#ifndef ZoneMaps_h
+#define ZoneMaps_h
+
+#include "ActDataManager.h"
+#include "ActMergerData.h"
+#include "ActModularData.h"
+#include "ActTPCData.h"
+#include "ActTypes.h"
+
+#include "TFile.h"
+#include "TList.h"
+#include "TParameter.h"
+#include "TTree.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "./ChainUtils.h"
+#include "./EventList.h"
+
+// Selection index written by runZoneMaps.cxx to RootFiles/ZoneMaps/ZoneMaps_Run_XXXX.root (ZoneTree)
+// One entry per block of kBlockSize Merger entries: min/max of key scalars (zone map) and one word of
+// flags per event (GATCONF in the low 16 bits, event bits and the cluster multiplicity above), so selections
+// are resolved on this small tree and applied to the full chains as an EventList before reading any object
+// An index older than any of its input files (Merger, Data, Filter) or of an older version is not used
+namespace ZoneMaps
+{
+constexpr int kBlockSize {1024};
+constexpr int kVersion {2};
+constexpr int kNClustersShift {22};
+constexpr std::uint32_t kNClustersMax {0xF};
+
+enum Flags : std::uint32_t
+{
+    kGatconfMask = 0xFFFF,
+    kHasLight = 1u << 16,
+    kHasHeavy = 1u << 17,
+    kHasBeam = 1u << 18,
+    kIsL1 = 1u << 19,
+    kHasRANSAC = 1u << 20, //!< Any cluster flagged IsRANSAC
+    kHasRP = 1u << 21,
+    kNClustersMask = kNClustersMax << kNClustersShift, //!< Filter cluster multiplicity, capped at kNClustersMax
+};
+
+inline int GetNClusters(std::uint32_t flags)
+{
+    return (flags & kNClustersMask) >> kNClustersShift;
+}
+
+struct Range
+{
+    float fMin {std::numeric_limits<float>::max()};
+    float fMax {std::numeric_limits<float>::lowest()};
+
+    void Add(float v)
+    {
+        if(!std::isfinite(v))
+            return;
+        fMin = std::min(fMin, v);
+        fMax = std::max(fMax, v);
+    }
+    // True if some value in the block may lie in [min, max]
+    bool Overlaps(float min, float max) const { return fMin <= max && min <= fMax; }
+};
+
+struct Block
+{
+    int fRun {};
+    std::int64_t fBegin {}; //!< First local entry of the block
+    Range fRPx, fThetaLight, fNClusters;
+    std::vector<std::uint32_t> fFlags; //!< Per event in the block
+
+    void SetBranches(TTree* tree)
+    {
+        tree->Branch("Run", &fRun);
+        tree->Branch("Begin", &fBegin);
+        tree->Branch("RPx", &fRPx.fMin, "RPxMin/F:RPxMax/F");
+        tree->Branch("ThetaLight", &fThetaLight.fMin, "ThetaLightMin/F:ThetaLightMax/F");
+        tree->Branch("NClusters", &fNClusters.fMin, "NClustersMin/F:NClustersMax/F");
+        tree->Branch("Flags", &fFlags);
+    }
+    void SetBranchAddresses(TTree* tree, std::vector<std::uint32_t>** flags)
+    {
+        tree->SetBranchAddress("Run", &fRun);
+        tree->SetBranchAddress("Begin", &fBegin);
+        tree->SetBranchAddress("RPx", &fRPx.fMin);
+        tree->SetBranchAddress("ThetaLight", &fThetaLight.fMin);
+        tree->SetBranchAddress("NClusters", &fNClusters.fMin);
+        tree->SetBranchAddress("Flags", flags);
+    }
+    void Clear(int run, std::int64_t begin)
+    {
+        *this = Block {};
+        fRun = run;
+        fBegin = begin;
+    }
+    void Add(const ActRoot::MergerData& mer, ActRoot::ModularData& mod, const ActRoot::TPCData& tpc)
+    {
+        std::uint32_t flags {static_cast<std::uint32_t>(mod.Get("GATCONF")) & kGatconfMask};
+        if(mer.fLightIdx != -1)
+            flags |= kHasLight;
+        if(mer.fHeavyIdx != -1)
+            flags |= kHasHeavy;
+        if(mer.fBeamIdx != -1)
+            flags |= kHasBeam;
+        if(mer.fLight.IsL1())
+            flags |= kIsL1;
+        if(tpc.fRPs.size())
+            flags |= kHasRP;
+        for(const auto& cl : tpc.fClusters)
+            if(cl.GetFlag("IsRANSAC"))
+                flags |= kHasRANSAC;
+        auto nclusters {std::min<std::uint32_t>(tpc.fClusters.size(), kNClustersMax)};
+        flags |= nclusters << kNClustersShift;
+        fFlags.push_back(flags);
+        if(mer.fLightIdx != -1)
+        {
+            fRPx.Add(mer.fRP.X());
+            fThetaLight.Add(mer.fThetaLight);
+        }
+        fNClusters.Add(tpc.fClusters.size());
+    }
+};
+
+// All blocks of the runs of dataman, read once; selections are then resolved in memory
+class Index
+{
+private:
+    std::vector<Block> fBlocks;
+    std::vector<int> fMissing;
+
+public:
+    Index(const std::string& dir, ActRoot::DataManager& dataman)
+    {
+        // Newest input per run
+        std::map<int, Long_t> inputs;
+        for(auto mode : {ActRoot::ModeType::EMerge, ActRoot::ModeType::EReadSilMod, ActRoot::ModeType::EFilter})
+            for(const auto& file : ChainUtils::GetFiles(dataman.GetChain(mode).get()))
+            {
+                auto& mtime {inputs[ChainUtils::GetRun(file)]};
+                mtime = std::max(mtime, ChainUtils::GetModTime(file));
+            }
+        for(auto run : ChainUtils::GetRuns(dataman.GetChain(ActRoot::ModeType::EMerge).get()))
+        {
+            auto file {ChainUtils::GetFileName(dir, "ZoneMaps_Run_", run)};
+            std::string problem;
+            std::unique_ptr<TFile> f;
+            TTree* tree {};
+            auto mtime {ChainUtils::GetModTime(file)};
+            if(mtime < 0)
+                problem = "missing";
+            else if(mtime < inputs[run])
+                problem = "older than its inputs";
+            else
+            {
+                f.reset(TFile::Open(file.c_str()));
+                if(!f || f->IsZombie() || !(tree = f->Get<TTree>("ZoneTree")))
+                    problem = "unreadable";
+                else if(auto* v {dynamic_cast<TParameter<int>*>(tree->GetUserInfo()->FindObject("Version"))};
+                        !v || v->GetVal() != kVersion)
+                    problem = "of an older version";
+            }
+            if(problem.size())
+            {
+                std::cout << "ZoneMaps::Index: " << file << " " << problem << ", run " << run
+                          << " not indexed (rerun runZoneMaps.cxx)" << '\n';
+                fMissing.push_back(run);
+                continue;
+            }
+            Block block;
+            std::vector<std::uint32_t>* flags {};
+            block.SetBranchAddresses(tree, &flags);
+            for(Long64_t i = 0; i < tree->GetEntries(); i++)
+            {
+                tree->GetEntry(i);
+                block.fFlags = *flags;
+                fBlocks.push_back(block);
+            }
+        }
+    }
+
+    // Events whose flags pass flagSel, in blocks passing zoneSel (zone cuts are conservative: repeat
+    // them as Filters on the selected events)
+    EventList Select(const std::function<bool(const Block&)>& zoneSel,
+                     const std::function<bool(std::uint32_t)>& flagSel) const
+    {
+        EventList ret;
+        for(const auto& block : fBlocks)
+        {
+            if(!zoneSel(block))
+                continue;
+            for(std::size_t i = 0; i < block.fFlags.size(); i++)
+                if(flagSel(block.fFlags[i]))
+                    ret.Add(block.fRun, block.fBegin + i);
+        }
+        ret.Sort();
+        return ret;
+    }
+    EventList Select(const std::function<bool(std::uint32_t)>& flagSel) const
+    {
+        return Select([](const Block&) { return true; }, flagSel);
+    }
+
+    // Loop over the flags of every indexed event
+    void Foreach(const std::function<void(int, std::int64_t, std::uint32_t)>& func) const
+    {
+        for(const auto& block : fBlocks)
+            for(std::size_t i = 0; i < block.fFlags.size(); i++)
+                func(block.fRun, block.fBegin + i, block.fFlags[i]);
+    }
+
+    std::size_t GetNBlocks() const { return fBlocks.size(); }
+    // All requested runs are indexed; otherwise fall back to reading the chains
+    bool IsComplete() const { return fMissing.empty(); }
+};
+
+inline bool HasGatconf(std::uint32_t flags, int gatconf)
+{
+    return (flags & kGatconfMask) == static_cast<std::uint32_t>(gatconf);
+}
+} // namespace ZoneMaps
+
+#endif
@@ -0,0 +1,41 @@
+#include "ActColors.h"
+#include "ActInputParser.h"
+
+#include <filesystem>
+#include <iostream>
+#include <string>
+
+#include "./PostAnalysis/CalibBundle.h"
+
+// Compiles the text calibrations of configs/calibration.conf and all SRIM tables into one binary bundle,
+// read with CalibBundle::Bundle (mmap). Rerun whenever any of the inputs changes
+void buildCalibBundle(const std::string& calibconf = "./configs/calibration.conf",
+                      const std::string& srimdir = "./Calibrations/SRIM/",
+                      const std::string& outfile = "./Calibrations/Bundle/calib_s2008.bin")
+{
+    ActRoot::InputParser parser {calibconf};
+    CalibBundle::Writer writer;
+
+    // ACTAR: LT and pad alignment
+    auto actar {parser.GetBlock("Actar")};
+    writer.AddInts("Actar/LookUp", actar->GetString("LookUp"));
+    if(actar->CheckTokenExists("PadAlign"))
+        writer.AddDoubles("Actar/PadAlign", actar->GetString("PadAlign"));
+
+    // Silicons: one section per file, named by its stem (s2008_f0...)
+    for(const auto& path : parser.GetBlock("Silicons")->GetStringVector("Paths"))
+        writer.AddNamed("Silicons/" + std::filesystem::path(path).stem().string(), path);
+
+    // SRIM: every table, named by its stem (1H_800mbar_95-5...)
+    for(const auto& entry : std::filesystem::directory_iterator(srimdir))
+        if(entry.path().extension() == ".txt")
+            writer.AddSRIM("SRIM/" + entry.path().stem().string(), entry.path().string());
+
+    writer.Write(outfile);
+
+    // Check it back
+    CalibBundle::Bundle bundle {outfile};
+    std::cout << BOLDGREEN << "Calibration bundle " << outfile << " with sections:" << RESET << '\n';
+    for(const auto& name : bundle.GetSectionNames())
+        std::cout << "  " << name << '\n';
+}
@@ -1,6 +1,39 @@
-#include "ActDataManager.h"
+#include "ActColors.h"
+#include "ActInputParser.h"
 
-void checkFileExists(){
-    ActRoot::DataManager dataman {"./configs/data.conf", ActRoot::ModeType::EReadTPC};
-    auto in {dataman.GetInput()};
-}
\ No newline at end of file
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "./PostAnalysis/ChainCatalog.h"
+
+// Fast validation of the run files of every stage against their cached catalogs (ChainCatalog.h)
+// Only new or modified files are opened; entries of aligned stages are checked against Merger
+void checkFileExists(const std::string& dataconf = "./configs/data.conf")
+{
+    ActRoot::InputParser parser {dataconf};
+    auto runs {parser.GetBlock("DataManager")->GetIntVector("Runs")};
+    auto headers {parser.GetBlockHeaders()};
+
+    std::map<int, Long64_t> reference;
+    bool ok {true};
+    for(const auto& stage : {"Merger", "Filter", "Data", "Cluster", "Raw"})
+    {
+        if(std::find(headers.begin(), headers.end(), stage) == headers.end())
+            continue;
+        ChainCatalog catalog {dataconf, stage};
+        auto reopened {catalog.Update(runs)};
+        std::cout << BOLDCYAN << "····· " << stage << " ·····" << RESET << '\n';
+        std::cout << "  reopened " << reopened << " of " << runs.size() << " files" << '\n';
+        // Raw and Cluster are not entry-aligned with the reconstruction stages
+        std::string s {stage};
+        bool aligned {s == "Merger" || s == "Filter" || s == "Data"};
+        ok = catalog.Validate(runs, aligned ? reference : std::map<int, Long64_t> {}) && ok;
+        if(s == "Merger")
+            reference = catalog.GetEntriesPerRun();
+    }
+    std::cout << (ok ? BOLDGREEN : BOLDRED) << (ok ? "All runs consistent" : "Inconsistent runs found") << RESET
+              << '\n';
+}
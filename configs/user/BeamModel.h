@@ -0,0 +1,84 @@
+#ifndef BeamModel_h
+#define BeamModel_h
+
+#include "ActCluster.h"
+
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace ActAlgorithm
+{
+// Beam phase-space model in pad units: beam lines are Y(X) = fY0 + fTY * X and Z(X) = fZ0 + fTZ * X
+// Built per run by Macros/buildBeamModel.cxx; row with run = -1 is the combination of all runs
+struct BeamModel
+{
+    int fRun {-1};
+    int fN {};
+    double fY0 {};
+    double fSY0 {};
+    double fZ0 {};
+    double fSZ0 {};
+    double fTY {};
+    double fSTY {};
+    double fTZ {};
+    double fSTZ {};
+
+    bool IsLoaded() const { return fN > 0; }
+
+    // Read row of given run from file
+    void Read(const std::string& file, int run = -1)
+    {
+        std::ifstream streamer {file};
+        if(!streamer)
+            throw std::runtime_error("BeamModel::Read(): could not open " + file);
+        std::string line;
+        while(std::getline(streamer, line))
+        {
+            if(line.empty() || line.front() == '#')
+                continue;
+            std::istringstream iss {line};
+            BeamModel m;
+            iss >> m.fRun >> m.fN >> m.fY0 >> m.fSY0 >> m.fZ0 >> m.fSZ0 >> m.fTY >> m.fSTY >> m.fTZ >> m.fSTZ;
+            if(m.fRun == run)
+            {
+                *this = m;
+                return;
+            }
+        }
+        throw std::runtime_error("BeamModel::Read(): no model for run " + std::to_string(run) + " in " + file);
+    }
+
+    // Constant-time compatibility test of a cluster line with the beam envelope at X = x
+    bool IsCompatible(const ActRoot::Cluster& cl, double nsigma, double x = 0) const
+    {
+        const auto& line {cl.GetLine()};
+        auto dir {line.GetDirection()};
+        if(dir.X() == 0)
+            return false;
+        auto p {line.GetPoint()};
+        auto ty {dir.Y() / dir.X()};
+        auto tz {dir.Z() / dir.X()};
+        auto y {p.Y() + ty * (x - p.X())};
+        auto z {p.Z() + tz * (x - p.X())};
+        auto sy {std::sqrt(fSY0 * fSY0 + fSTY * fSTY * x * x)};
+        auto sz {std::sqrt(fSZ0 * fSZ0 + fSTZ * fSTZ * x * x)};
+        return std::abs(ty - fTY) <= nsigma * fSTY && std::abs(tz - fTZ) <= nsigma * fSTZ &&
+               std::abs(y - (fY0 + fTY * x)) <= nsigma * sy && std::abs(z - (fZ0 + fTZ * x)) <= nsigma * sz;
+    }
+
+    void Print() const
+    {
+        std::cout << "  BeamModel run  : " << fRun << " (" << fN << " beams)" << '\n';
+        std::cout << "  -> Y0  : " << fY0 << " +/- " << fSY0 << '\n';
+        std::cout << "  -> Z0  : " << fZ0 << " +/- " << fSZ0 << '\n';
+        std::cout << "  -> dY/dX : " << fTY << " +/- " << fSTY << '\n';
+        std::cout << "  -> dZ/dX : " << fTZ << " +/- " << fSTZ << '\n';
+    }
+};
+} // namespace ActAlgorithm
+
+#endif
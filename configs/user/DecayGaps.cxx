@@ -0,0 +1,67 @@
+#include "DecayGaps.h"
+
+#include "ActCluster.h"
+#include "ActColors.h"
+#include "ActInputParser.h"
+#include "ActMergerData.h"
+#include "ActTPCData.h"
+
+#include <cmath>
+#include <memory>
+
+void ActAlgorithm::DecayGaps::ReadConfiguration(std::shared_ptr<ActRoot::InputBlock> block)
+{
+    fIsEnabled = block->GetBool("IsEnabled");
+    if(!fIsEnabled)
+        return;
+    if(block->CheckTokenExists("PadSize"))
+        fPadSize = block->GetDouble("PadSize");
+    if(block->CheckTokenExists("DriftFactor"))
+        fDriftFactor = block->GetDouble("DriftFactor");
+}
+
+std::vector<std::string> ActAlgorithm::DecayGaps::GetColumns() const
+{
+    return {"DeltaX_RP_ClusterLight", "DeltaZ_RP_ClusterLight"};
+}
+
+void ActAlgorithm::DecayGaps::Run(const ActRoot::MergerData& mer, ActRoot::TPCData& tpc, std::vector<double>& out)
+{
+    out.assign(out.size(), NAN);
+    if(mer.fLightIdx == -1)
+        return;
+    // Gap between RP and first voxel of light cluster along its direction
+    auto& clusterLight {tpc.fClusters[mer.fLightIdx]};
+    clusterLight.GetRefToLine().AlignUsingPoint(mer.fRP);
+    clusterLight.SortAlongDir();
+    const auto& voxels {clusterLight.GetRefToVoxels()};
+    if(voxels.empty())
+        return;
+    auto first {voxels.front().GetPosition()};
+    out[0] = first.X() * fPadSize - mer.fRP.X();
+    out[1] = first.Z() * fDriftFactor - mer.fRP.Z();
+    if(fIsVerbose)
+    {
+        std::cout << BOLDGREEN << "-- DecayGaps --" << '\n';
+        std::cout << "Delta X : " << out[0] << '\n';
+        std::cout << "Delta Z : " << out[1] << RESET << '\n';
+    }
+}
+
+void ActAlgorithm::DecayGaps::Print() const
+{
+    std::cout << BOLDCYAN << "····· " << GetHookID() << " ·····" << '\n';
+    if(!fIsEnabled)
+    {
+        std::cout << "······························" << RESET << '\n';
+        return;
+    }
+    std::cout << "  PadSize        : " << fPadSize << '\n';
+    std::cout << "  DriftFactor    : " << fDriftFactor << RESET << '\n';
+}
+
+// Create symbol to load class from .so
+extern "C" ActAlgorithm::DecayGaps* CreateMergerHook()
+{
+    return new ActAlgorithm::DecayGaps;
+}
@@ -0,0 +1,19 @@
+#include "VMergerHook.h"
+
+namespace ActAlgorithm
+{
+class DecayGaps : public VMergerHook
+{
+public:
+    double fPadSize {2};         //!< Pad size in mm
+    double fDriftFactor {2.208}; //!< Same as [Merger] DriftFactor
+
+public:
+    DecayGaps() : VMergerHook("DecayGaps") {}
+
+    void ReadConfiguration(std::shared_ptr<ActRoot::InputBlock> block) override;
+    std::vector<std::string> GetColumns() const override;
+    void Run(const ActRoot::MergerData& mer, ActRoot::TPCData& tpc, std::vector<double>& out) override;
+    void Print() const override;
+};
+} // namespace ActAlgorithm
@@ -0,0 +1,109 @@
+#include "EventClassifier.h"
+
+#include "ActCluster.h"
+#include "ActColors.h"
+#include "ActInputParser.h"
+#include "ActTPCData.h"
+
+#include "TMath.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+
+// Generated at build time from Models/event_classifier.txt by Models/flatten_trees.py
+#include "EventClassifierModel.h"
+
+void ActAlgorithm::EventClassifier::ReadConfiguration(std::shared_ptr<ActRoot::InputBlock> block)
+{
+    fIsEnabled = block->GetBool("IsEnabled");
+    if(!fIsEnabled)
+        return;
+    if(block->CheckTokenExists("MinScore"))
+        fMinScore = block->GetDouble("MinScore");
+}
+
+void ActAlgorithm::EventClassifier::Run()
+{
+    if(!fIsEnabled)
+        return;
+
+    auto& clusters {fTPCData->fClusters};
+    if(clusters.empty())
+        return;
+
+    // Features, in the order of the model: NClusters, NBeamLike, MaxTheta, MinTheta, QTotal, QMaxCluster, RPX
+    float x[EventClassifierModel::kNFeatures] {};
+    float thetaMax {0};
+    float thetaMin {180};
+    float qtotal {};
+    float qmax {};
+    int nbeam {};
+    for(const auto& cl : clusters)
+    {
+        float q {};
+        for(const auto& v : cl.GetRefToVoxels())
+            q += v.GetCharge();
+        qtotal += q;
+        qmax = std::max(qmax, q);
+        if(cl.GetIsBeamLike())
+        {
+            nbeam++;
+            continue;
+        }
+        auto dir {cl.GetLine().GetDirection().Unit()};
+        float theta = std::acos(std::abs(dir.X())) * TMath::RadToDeg();
+        thetaMax = std::max(thetaMax, theta);
+        thetaMin = std::min(thetaMin, theta);
+    }
+    x[0] = clusters.size();
+    x[1] = nbeam;
+    x[2] = thetaMax;
+    x[3] = (nbeam == static_cast<int>(clusters.size())) ? 0 : thetaMin;
+    x[4] = qtotal;
+    x[5] = qmax;
+    x[6] = fTPCData->fRPs.size() ? fTPCData->fRPs.front().X() : -1;
+
+    // Evaluate model
+    float scores[EventClassifierModel::kNClasses] {};
+    EventClassifierModel::Predict(x, scores);
+    auto best {static_cast<int>(std::max_element(scores, scores + EventClassifierModel::kNClasses) - scores)};
+    if(scores[best] < fMinScore)
+        best = 0;
+    std::string label {EventClassifierModel::kClasses[best]};
+
+    // Store label as a cluster flag so it is kept in the filter output
+    for(auto& cl : clusters)
+        cl.SetFlag("Class" + label, true);
+
+    if(fIsVerbose)
+    {
+        std::cout << BOLDGREEN << "-- EventClassifier --" << '\n';
+        for(int f = 0; f < EventClassifierModel::kNFeatures; f++)
+            std::cout << "  " << EventClassifierModel::kFeatures[f] << " : " << x[f] << '\n';
+        std::cout << "-> Class : " << label << " with score " << scores[best] << RESET << '\n';
+    }
+}
+
+void ActAlgorithm::EventClassifier::Print() const
+{
+    std::cout << BOLDCYAN << "····· " << GetActionID() << " ·····" << '\n';
+    if(!fIsEnabled)
+    {
+        std::cout << "······························" << RESET << '\n';
+        return;
+    }
+    std::cout << "  MinScore       : " << fMinScore << '\n';
+    std::cout << "  Model          : " << EventClassifierModel::kNTrees << " trees of depth "
+              << EventClassifierModel::kDepth << '\n';
+    std::cout << "  Classes        : ";
+    for(const auto* c : EventClassifierModel::kClasses)
+        std::cout << c << " ";
+    std::cout << RESET << '\n';
+}
+
+// Create symbol to load class from .so
+extern "C" ActAlgorithm::EventClassifier* CreateUserAction()
+{
+    return new ActAlgorithm::EventClassifier;
+}
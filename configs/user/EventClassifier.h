@@ -0,0 +1,19 @@
+#include "ActVAction.h"
+
+#include <string>
+
+namespace ActAlgorithm
+{
+class EventClassifier : public VAction
+{
+public:
+    double fMinScore {0}; //!< Min raw score of the winning class to flag the event; otherwise "Other"
+
+public:
+    EventClassifier() : VAction("EventClassifier") {}
+
+    void ReadConfiguration(std::shared_ptr<ActRoot::InputBlock> block) override;
+    void Run() override;
+    void Print() const override;
+};
+} // namespace ActAlgorithm
@@ -0,0 +1,127 @@
+#!/usr/bin/env python3
+"""Flatten an XGBoost text dump into a branch-free C++ header.
+
+Every tree is padded to a complete binary tree of the model depth and stored as
+feature/threshold/leaf tables, so evaluation is a fixed number of
+idx = 2 * idx + 1 + (x[f[idx]] >= t[idx]) steps per tree, without branches.
+
+Usage: flatten_trees.py <model.txt> <output.h>
+"""
+
+import re
+import sys
+
+NODE = re.compile(r"^\s*(\d+):\[(\w+)<([^\]]+)\] yes=(\d+),no=(\d+)")
+LEAF = re.compile(r"^\s*(\d+):leaf=(\S+)")
+
+
+def parse(path):
+    classes, features, trees = [], [], []
+    with open(path) as f:
+        for line in f:
+            if line.startswith("# classes:"):
+                classes = [c.strip() for c in line.split(":", 1)[1].split(",")]
+            elif line.startswith("# features:"):
+                features = [c.strip() for c in line.split(":", 1)[1].split(",")]
+            elif line.startswith("booster"):
+                trees.append({})
+            elif m := NODE.match(line):
+                trees[-1][int(m[1])] = (m[2], float(m[3]), int(m[4]), int(m[5]))
+            elif m := LEAF.match(line):
+                trees[-1][int(m[1])] = float(m[2])
+    if not classes or not features or not trees:
+        sys.exit("flatten_trees.py: missing classes, features or boosters in " + path)
+    return classes, features, trees
+
+
+def depth(tree, node=0):
+    n = tree[node]
+    if isinstance(n, float):
+        return 0
+    return 1 + max(depth(tree, n[2]), depth(tree, n[3]))
+
+
+def flatten(tree, features, d):
+    nint = 2**d - 1
+    feat, thr, leaves = [0] * nint, [0.0] * nint, [0.0] * (2**d)
+
+    def fill(node, pos, level):
+        n = tree[node]
+        if level == d:
+            leaves[pos - nint] = n
+            return
+        if isinstance(n, float):
+            # Leaf above full depth: always go left, same value in both subtrees
+            feat[pos], thr[pos] = 0, float("inf")
+            fill(node, 2 * pos + 1, level + 1)
+            fill(node, 2 * pos + 2, level + 1)
+            return
+        name, t, yes, no = n
+        feat[pos], thr[pos] = features.index(name), t
+        fill(yes, 2 * pos + 1, level + 1)
+        fill(no, 2 * pos + 2, level + 1)
+
+    fill(0, 0, 0)
+    return feat, thr, leaves
+
+
+def fmt(x):
+    if x == float("inf"):
+        return "std::numeric_limits<float>::infinity()"
+    return repr(float(x)) + "f"
+
+
+def main(model, out):
+    classes, features, trees = parse(model)
+    d = max(1, max(depth(t) for t in trees))
+    flat = [flatten(t, features, d) for t in trees]
+    nint, nleaf = 2**d - 1, 2**d
+    lines = [
+        "// Generated by flatten_trees.py from " + model.split("/")[-1] + ", do not edit",
+        "#ifndef EventClassifierModel_h",
+        "#define EventClassifierModel_h",
+        "",
+        "#include <limits>",
+        "",
+        "namespace EventClassifierModel",
+        "{",
+        f"constexpr int kNClasses {{{len(classes)}}};",
+        f"constexpr int kNFeatures {{{len(features)}}};",
+        f"constexpr int kNTrees {{{len(trees)}}};",
+        f"constexpr int kDepth {{{d}}};",
+        "constexpr const char* kClasses[kNClasses] {" + ", ".join(f'"{c}"' for c in classes) + "};",
+        "constexpr const char* kFeatures[kNFeatures] {" + ", ".join(f'"{c}"' for c in features) + "};",
+        f"constexpr int kFeature[kNTrees][{nint}] {{",
+    ]
+    lines += ["    {" + ", ".join(map(str, f)) + "}," for f, _, _ in flat]
+    lines += ["};", f"constexpr float kThreshold[kNTrees][{nint}] {{"]
+    lines += ["    {" + ", ".join(map(fmt, t)) + "}," for _, t, _ in flat]
+    lines += ["};", f"constexpr float kLeaf[kNTrees][{nleaf}] {{"]
+    lines += ["    {" + ", ".join(map(fmt, l)) + "}," for _, _, l in flat]
+    lines += [
+        "};",
+        "",
+        "// Adds the raw boosted score of each class to scores",
+        "inline void Predict(const float* x, float* scores)",
+        "{",
+        "    for(int t = 0; t < kNTrees; t++)",
+        "    {",
+        "        int idx {};",
+    ]
+    lines += ["        idx = 2 * idx + 1 + (x[kFeature[t][idx]] >= kThreshold[t][idx]);"] * d
+    lines += [
+        f"        scores[t % kNClasses] += kLeaf[t][idx - {nint}];",
+        "    }",
+        "}",
+        "} // namespace EventClassifierModel",
+        "",
+        "#endif",
+    ]
+    with open(out, "w") as f:
+        f.write("\n".join(lines) + "\n")
+
+
+if __name__ == "__main__":
+    if len(sys.argv) != 3:
+        sys.exit(__doc__)
+    main(sys.argv[1], sys.argv[2])
@@ -0,0 +1,77 @@
+#ifndef PileUpCut_h
+#define PileUpCut_h
+
+#include "ActCluster.h"
+#include "ActInputParser.h"
+
+#include "TMath.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+namespace ActAlgorithm
+{
+// Double-beam criterion of the TagPileUp action. Header only so that Macros/pileUpRates.cxx evaluates the
+// same cut on the Cluster stage, which is the input of TagPileUp (first action of the filter)
+struct PileUpCut
+{
+    double fEntranceX {10}; //!< Clusters starting before this X (pads) are entrance candidates
+    double fMaxAngle {10};  //!< Max angle (deg) wrt X axis to consider a cluster beam-like
+    int fMinVoxels {10};    //!< Min number of voxels of a candidate
+    double fMinZSep {6};    //!< Min separation in Z (btb) at the entrance to tag pile-up
+
+    void Read(std::shared_ptr<ActRoot::InputBlock> block)
+    {
+        if(block->CheckTokenExists("EntranceX"))
+            fEntranceX = block->GetDouble("EntranceX");
+        if(block->CheckTokenExists("MaxAngle"))
+            fMaxAngle = block->GetDouble("MaxAngle");
+        if(block->CheckTokenExists("MinVoxels"))
+            fMinVoxels = block->GetInt("MinVoxels");
+        if(block->CheckTokenExists("MinZSep"))
+            fMinZSep = block->GetDouble("MinZSep");
+    }
+
+    // Z of every beam-like cluster entering the chamber, evaluated at X = fEntranceX
+    std::vector<double> GetEntranceZs(const std::vector<ActRoot::Cluster>& clusters) const
+    {
+        auto cosMax {std::cos(fMaxAngle * TMath::DegToRad())};
+        std::vector<double> zs;
+        for(const auto& cl : clusters)
+        {
+            if(cl.GetXRange().first > fEntranceX)
+                continue;
+            if(static_cast<int>(cl.GetRefToVoxels().size()) < fMinVoxels)
+                continue;
+            const auto& line {cl.GetLine()};
+            auto dir {line.GetDirection().Unit()};
+            if(std::abs(dir.X()) < cosMax)
+                continue;
+            auto p {line.GetPoint()};
+            zs.push_back(p.Z() + dir.Z() / dir.X() * (fEntranceX - p.X()));
+        }
+        return zs;
+    }
+
+    // Z separation of the entrance beams (-1 with less than two)
+    double GetZSeparation(const std::vector<ActRoot::Cluster>& clusters) const
+    {
+        if(clusters.size() < 2)
+            return -1;
+        auto zs {GetEntranceZs(clusters)};
+        if(zs.size() < 2)
+            return -1;
+        auto [zmin, zmax] {std::minmax_element(zs.begin(), zs.end())};
+        return *zmax - *zmin;
+    }
+
+    bool IsPileUp(const std::vector<ActRoot::Cluster>& clusters) const
+    {
+        return GetZSeparation(clusters) >= fMinZSep;
+    }
+};
+} // namespace ActAlgorithm
+
+#endif
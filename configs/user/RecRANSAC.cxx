@@ -10,12 +10,38 @@
 
 #include <algorithm>
 #include <memory>
+#include <stdexcept>
+#include <string>
 
 void ActAlgorithm::RecRANSAC::ReadConfiguration(std::shared_ptr<ActRoot::InputBlock> block)
 {
     fIsEnabled = block->GetBool("IsEnabled");
     if(!fIsEnabled)
         return;
+    if(block->CheckTokenExists("BeamModel"))
+        fBeamModelFile = block->GetString("BeamModel");
+    if(block->CheckTokenExists("BeamModelRun"))
+        fBeamModelRun = block->GetInt("BeamModelRun");
+    if(block->CheckTokenExists("DataConf"))
+        fDataConf = block->GetString("DataConf");
+    if(block->CheckTokenExists("BeamModelSigmas"))
+        fBeamModelSigmas = block->GetDouble("BeamModelSigmas");
+    if(fBeamModelFile.size())
+    {
+        // Actions do not know the run of the event: the row is that of the run being filtered, so the filter
+        // must process one run per call (setRuns.sh <run> && actroot -f), unless a row is forced
+        if(fBeamModelRun == -2)
+        {
+            ActRoot::InputParser parser {fDataConf};
+            auto runs {parser.GetBlock("DataManager")->GetIntVector("Runs")};
+            if(runs.size() != 1)
+                throw std::runtime_error("RecRANSAC::ReadConfiguration(): BeamModel is per run but " + fDataConf +
+                                         " lists " + std::to_string(runs.size()) +
+                                         " runs; filter one run per call or set BeamModelRun");
+            fBeamModelRun = runs.front();
+        }
+        fBeamModel.Read(fBeamModelFile, fBeamModelRun);
+    }
     // if(block->CheckTokenExists("MaxAngle"))
     //     fMaxAngle = block->GetDouble("MaxAngle");
     // if(block->CheckTokenExists("MinLength"))
@@ -29,17 +55,25 @@ void ActAlgorithm::RecRANSAC::Run()
     if(!fIsEnabled)
         return;
 
-    // Determine beam likes in event, calling DetermineBeamLikes from FindRP before
-    if(fMultiAction->HasAction("FindRP"))
+    // Trigger only when all clusters are beams. BeamLike is owned by FindRP (DetermineBeamLikes, run again in
+    // FindRP::Run), so the beam model is only used for this trigger and never written to the clusters
+    bool trigger {};
+    if(fBeamModel.IsLoaded())
+        trigger = std::all_of(fTPCData->fClusters.begin(), fTPCData->fClusters.end(), [&](const ActRoot::Cluster& cl)
+                              { return fBeamModel.IsCompatible(cl, fBeamModelSigmas); });
+    else
     {
-        auto findrp {std::dynamic_pointer_cast<ActAlgorithm::Actions::FindRP>(fMultiAction->GetAction("FindRP"))};
-        if(findrp)
-            findrp->ExecInnerAction("DetermineBeamLikes");
+        // otherwise call DetermineBeamLikes from FindRP before
+        if(fMultiAction->HasAction("FindRP"))
+        {
+            auto findrp {
+                std::dynamic_pointer_cast<ActAlgorithm::Actions::FindRP>(fMultiAction->GetAction("FindRP"))};
+            if(findrp)
+                findrp->ExecInnerAction("DetermineBeamLikes");
+        }
+        trigger = std::all_of(fTPCData->fClusters.begin(), fTPCData->fClusters.end(),
+                              [](const ActRoot::Cluster& cl) { return cl.GetIsBeamLike(); });
     }
-
-    // Trigger only when all are beam-likes
-    auto trigger {std::all_of(fTPCData->fClusters.begin(), fTPCData->fClusters.end(),
-                              [](const ActRoot::Cluster& cl) { return cl.GetIsBeamLike(); })};
     if(!trigger)
         return;
     // if(fTPCData->fClusters.size() > 1)
@@ -79,7 +113,15 @@ void ActAlgorithm::RecRANSAC::Print() const
         std::cout << "······························" << RESET << '\n';
         return;
     }
-    std::cout << "  No parameters yet" << RESET << '\n';
+    if(fBeamModel.IsLoaded())
+    {
+        std::cout << "  BeamModelFile  : " << fBeamModelFile << '\n';
+        std::cout << "  BeamModelSigmas: " << fBeamModelSigmas << '\n';
+        fBeamModel.Print();
+    }
+    else
+        std::cout << "  Trigger on beam-likes of FindRP" << '\n';
+    std::cout << RESET;
 }
 
 // Create symbol to load class from .so
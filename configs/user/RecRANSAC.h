@@ -1,11 +1,21 @@
 #include "ActVAction.h"
 
+#include "BeamModel.h"
+
+#include <string>
+
 namespace ActAlgorithm
 {
 class RecRANSAC : public VAction
 {
 public:
     // Parameters of the action
+    std::string fBeamModelFile {};                 //!< File with per-run beam models; empty to use FindRP beam-likes
+    std::string fDataConf {"./configs/data.conf"}; //!< Its single run selects the beam model row
+    int fBeamModelRun {-2};                        //!< Forced row of the beam model (-1 = all runs, -2 = from DataConf)
+    double fBeamModelSigmas {3};                   //!< Width of the beam envelope in sigmas
+    BeamModel fBeamModel {};
+
 public:
     RecRANSAC() : VAction("RecRANSAC") {}
 
@@ -0,0 +1,67 @@
+#include "TagPileUp.h"
+
+#include "ActCluster.h"
+#include "ActColors.h"
+#include "ActInputParser.h"
+#include "ActTPCData.h"
+
+#include <iostream>
+#include <memory>
+
+void ActAlgorithm::TagPileUp::ReadConfiguration(std::shared_ptr<ActRoot::InputBlock> block)
+{
+    fIsEnabled = block->GetBool("IsEnabled");
+    if(!fIsEnabled)
+        return;
+    fCut.Read(block);
+    if(block->CheckTokenExists("DropEvent"))
+        fDropEvent = block->GetBool("DropEvent");
+}
+
+void ActAlgorithm::TagPileUp::Run()
+{
+    if(!fIsEnabled)
+        return;
+
+    auto& clusters {fTPCData->fClusters};
+    auto sep {fCut.GetZSeparation(clusters)};
+    if(sep < fCut.fMinZSep)
+        return;
+
+    if(fIsVerbose)
+    {
+        std::cout << BOLDYELLOW << "-- TagPileUp --" << '\n';
+        std::cout << "Entrance beams : " << fCut.GetEntranceZs(clusters).size() << '\n';
+        std::cout << "Z separation   : " << sep << '\n';
+        std::cout << (fDropEvent ? "Event dropped" : "Event tagged") << RESET << '\n';
+    }
+    // Drop the event so the remaining actions run on an empty TPCData
+    if(fDropEvent)
+    {
+        clusters.clear();
+        return;
+    }
+    for(auto& cl : clusters)
+        cl.SetFlag("IsPileUp", true);
+}
+
+void ActAlgorithm::TagPileUp::Print() const
+{
+    std::cout << BOLDCYAN << "····· " << GetActionID() << " ·····" << '\n';
+    if(!fIsEnabled)
+    {
+        std::cout << "······························" << RESET << '\n';
+        return;
+    }
+    std::cout << "  EntranceX      : " << fCut.fEntranceX << '\n';
+    std::cout << "  MaxAngle       : " << fCut.fMaxAngle << '\n';
+    std::cout << "  MinVoxels      : " << fCut.fMinVoxels << '\n';
+    std::cout << "  MinZSep        : " << fCut.fMinZSep << '\n';
+    std::cout << "  DropEvent      : " << std::boolalpha << fDropEvent << RESET << '\n';
+}
+
+// Create symbol to load class from .so
+extern "C" ActAlgorithm::TagPileUp* CreateUserAction()
+{
+    return new ActAlgorithm::TagPileUp;
+}
@@ -0,0 +1,20 @@
+#include "ActVAction.h"
+
+#include "PileUpCut.h"
+
+namespace ActAlgorithm
+{
+class TagPileUp : public VAction
+{
+public:
+    PileUpCut fCut {};       //!< Double-beam criterion, shared with Macros/pileUpRates.cxx
+    bool fDropEvent {false}; //!< Clear clusters of tagged events instead of only flagging them
+
+public:
+    TagPileUp() : VAction("TagPileUp") {}
+
+    void ReadConfiguration(std::shared_ptr<ActRoot::InputBlock> block) override;
+    void Run() override;
+    void Print() const override;
+};
+} // namespace ActAlgorithm
@@ -0,0 +1,40 @@
+#ifndef VMergerHook_h
+#define VMergerHook_h
+
+#include "ActInputParser.h"
+#include "ActMergerData.h"
+#include "ActTPCData.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ActAlgorithm
+{
+// Interface of user hooks run after the merger, once light/heavy/beam and SP are assigned
+// Each hook declares its columns and fills them per event; runMergerHooks.cxx stores them
+// in RootFiles/Hooks as a friend tree of the Merger one
+class VMergerHook
+{
+protected:
+    std::string fHookID {};
+    bool fIsEnabled {true};
+    bool fIsVerbose {false};
+
+public:
+    VMergerHook(const std::string& id) : fHookID(id) {}
+    virtual ~VMergerHook() = default;
+
+    const std::string& GetHookID() const { return fHookID; }
+    bool GetIsEnabled() const { return fIsEnabled; }
+    void SetIsVerbose(bool verbose) { fIsVerbose = verbose; }
+
+    virtual void ReadConfiguration(std::shared_ptr<ActRoot::InputBlock> block) = 0;
+    // Names of the double columns filled by Run, in order
+    virtual std::vector<std::string> GetColumns() const = 0;
+    virtual void Run(const ActRoot::MergerData& mer, ActRoot::TPCData& tpc, std::vector<double>& out) = 0;
+    virtual void Print() const = 0;
+};
+} // namespace ActAlgorithm
+
+#endif
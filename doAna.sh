@@ -14,3 +14,24 @@ actroot -f &&
 #
 # ## 4-> Do the merging
 actroot -m
+#
+# ## 5-> Write per-cluster summary of the filter in RootFiles/Summary
+# (append && to the lines above when enabling these steps)
+# root -l -b -q runClusterSummary.cxx
+# and of the Cluster stage, for Macros/BeamELoss
+# root -l -b -q 'runClusterSummary.cxx("./configs/data.conf", "Cluster")'
+#
+# ## 6-> Write compact voxel encoding of the filter in RootFiles/Compact
+# root -l -b -q runCompactVoxels.cxx
+#
+# ## 7-> Run merger hooks to store derived quantities in RootFiles/Hooks
+# root -l -b -q runMergerHooks.cxx
+#
+# ## 8-> Write entry-aligned analysis tree of configs/analysis.conf in RootFiles/Analysis
+# root -l -b -q runAnalysisTree.cxx
+#
+# ## 9-> Write skims of configs/skims.conf in RootFiles/Skims
+# root -l -b -q runSkims.cxx
+#
+# ## 10-> Write zone maps and event flags of the merger in RootFiles/ZoneMaps
+# root -l -b -q runZoneMaps.cxx
@@ -0,0 +1,65 @@
+#!/bin/bash
+
+## Nearline mode: watch a drop directory for new raw runs and process them as they arrive
+## Usage: ./doNearline.sh [drop dir ([Raw] Path of data.conf)] [poll seconds (60)]
+## A run is taken when Tree_Run_XXXX_Merged.root keeps the same size over one poll interval
+## Files dropped elsewhere than the [Raw] Path are linked there before processing, since actroot reads that Path
+## Spectra of Pipe0/Pipe1 per run go to RootFiles/Nearline and are added into Spectra_Sum.root
+
+conf="./configs/data.conf"
+raw=$(awk '/^\[/ {block=$0} block=="[Raw]" && /^Path:/ {print $2; exit}' "${conf}")
+if [ -z "${raw}" ]; then
+  echo "No [Raw] Path in ${conf}"
+  exit 1
+fi
+drop="${1:-${raw}}"
+poll="${2:-60}"
+out="./RootFiles/Nearline"
+done_list="${out}/processed.txt"
+
+touch "${done_list}"
+declare -A sizes
+
+## Run all stages for one run, on a copy of data.conf restored afterwards
+process() {
+  local run=$1
+  cp "${conf}" "${conf}.nearline"
+  ./setRuns.sh "${run}" &&
+    actroot -r tpc &&
+    actroot -r sil &&
+    actroot -f &&
+    actroot -m &&
+    root -l -b -q runClusterSummary.cxx &&
+    root -l -b -q "runNearlineSpectra.cxx(${run})"
+  local status=$?
+  mv "${conf}.nearline" "${conf}"
+  return ${status}
+}
+
+echo "Watching ${drop} every ${poll} s, raw files read from ${raw}"
+while true; do
+  for file in "${drop}"/Tree_Run_*_Merged.root; do
+    [ -e "${file}" ] || continue
+    run=$(basename "${file}" | sed -E 's/Tree_Run_0*([0-9]+)_Merged.root/\1/')
+    grep -qx "${run}" "${done_list}" && continue
+    size=$(stat -c %s "${file}")
+    ## Wait for a stable, non-empty size
+    if [ "${size}" -eq 0 ] || [ "${sizes[${run}]}" != "${size}" ]; then
+      sizes[${run}]=${size}
+      continue
+    fi
+    if [ "$(realpath "${drop}")" != "$(realpath "${raw}")" ]; then
+      ln -sf "$(realpath "${file}")" "${raw%/}/$(basename "${file}")"
+    fi
+    echo "-> Run ${run}: processing"
+    if process "${run}"; then
+      echo "${run}" >>"${done_list}"
+      hadd -f "${out}/Spectra_Sum.root" "${out}"/Spectra_Run_*.root >/dev/null &&
+        echo "-> Run ${run}: added to ${out}/Spectra_Sum.root"
+    else
+      echo "-> Run ${run}: failed, will retry"
+      unset "sizes[${run}]"
+    fi
+  done
+  sleep "${poll}"
+done
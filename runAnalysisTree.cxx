@@ -0,0 +1,44 @@
+#include "ActColors.h"
+#include "ActDataManager.h"
+#include "ActInputParser.h"
+#include "ActTypes.h"
+
+#include "ROOT/RDataFrame.hxx"
+#include "ROOT/RSnapshotOptions.hxx"
+
+#include <iostream>
+#include <string>
+
+#include "./PostAnalysis/ChainUtils.h"
+#include "./PostAnalysis/IOConfig.h"
+
+// Copies the branches of configs/analysis.conf from all stages into one entry-aligned tree per run
+void runAnalysisTree(const std::string& dataconf = "./configs/data.conf",
+                     const std::string& anaconf = "./configs/analysis.conf")
+{
+    ActRoot::InputParser parser {anaconf};
+    auto branches {parser.GetBlock("AnalysisTree")->GetStringVector("Branches")};
+
+    ActRoot::DataManager dataman {dataconf, ActRoot::ModeType::EMerge};
+    auto runs {ChainUtils::GetRuns(dataman.GetChain().get())};
+    for(auto run : runs)
+    {
+        dataman.SetRuns(run, run);
+        auto chain {dataman.GetChain()};
+        auto chainData {dataman.GetChain(ActRoot::ModeType::EReadSilMod)};
+        chain->AddFriend(chainData.get());
+        auto chainFilter {dataman.GetChain(ActRoot::ModeType::EFilter)};
+        chain->AddFriend(chainFilter.get());
+
+        // No implicit MT so that entries keep the order of the other stages
+        ROOT::RDataFrame df {*chain};
+        auto outname {ChainUtils::GetFileName("./RootFiles/Analysis/", "Analysis_Run_", run)};
+        // Fully split objects: each member gets its own sub-branch (fRP.fCoordinates.fX, fRPs.fCoordinates.fX...)
+        // so readers declaring only member columns do not deserialize whole objects
+        auto opts {IOConfig::GetSnapshotOptions()};
+        opts.fSplitLevel = 99;
+        opts.fOutputFormat = ROOT::RDF::ESnapshotOutputFormat::kTTree; // Read back as a TChain by GetAnalysisChain
+        df.Snapshot("AnalysisTree", outname, branches, opts);
+        std::cout << BOLDGREEN << "Run " << run << " -> " << outname << RESET << '\n';
+    }
+}
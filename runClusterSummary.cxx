@@ -0,0 +1,52 @@
+#include "ActColors.h"
+#include "ActDataManager.h"
+#include "ActTPCData.h"
+#include "ActTypes.h"
+
+#include "TFile.h"
+#include "TTree.h"
+#include "TTreeReader.h"
+#include "TTreeReaderValue.h"
+
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "./PostAnalysis/ChainUtils.h"
+#include "./PostAnalysis/ClusterSummary.h"
+
+// Writes the per-cluster summary of the Filter output to RootFiles/Summary/Summary_Run_XXXX.root
+// With stage = "Cluster", that of the Cluster stage (EReadTPC, input of the filter) to SummaryCluster_Run_XXXX.root
+void runClusterSummary(const std::string& dataconf = "./configs/data.conf", const std::string& stage = "Filter")
+{
+    if(stage != "Filter" && stage != "Cluster")
+        throw std::runtime_error("runClusterSummary(): stage must be Filter or Cluster, not " + stage);
+    auto mode {stage == "Filter" ? ActRoot::ModeType::EFilter : ActRoot::ModeType::EReadTPC};
+    auto begin {stage == "Filter" ? "Summary_Run_" : "SummaryCluster_Run_"};
+    ActRoot::DataManager dataman {dataconf, mode};
+    auto runs {ChainUtils::GetRuns(dataman.GetChain().get())};
+    for(auto run : runs)
+    {
+        dataman.SetRuns(run, run);
+        auto chain {dataman.GetChain()};
+
+        auto outname {ChainUtils::GetFileName("./RootFiles/Summary/", begin, run)};
+        auto fout {std::make_unique<TFile>(outname.c_str(), "recreate")};
+        auto* tree {new TTree {"SummaryTree", ("Per-cluster summary of " + stage).c_str()}};
+        ClusterSummary::Data data;
+        data.SetBranches(tree);
+
+        TTreeReader reader {chain.get()};
+        TTreeReaderValue<ActRoot::TPCData> tpc {reader, "TPCData"};
+        while(reader.Next())
+        {
+            data.Fill(*tpc);
+            tree->Fill();
+        }
+        fout->cd();
+        tree->Write();
+        fout->Close();
+        std::cout << BOLDGREEN << "Run " << run << " -> " << outname << RESET << '\n';
+    }
+}
@@ -0,0 +1,76 @@
+#include "ActColors.h"
+#include "ActDataManager.h"
+#include "ActTPCData.h"
+#include "ActTypes.h"
+
+#include "Compression.h"
+#include "TBranch.h"
+#include "TFile.h"
+#include "TTree.h"
+#include "TTreeReader.h"
+#include "TTreeReaderValue.h"
+
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "./PostAnalysis/ChainUtils.h"
+#include "./PostAnalysis/VoxelCodec.h"
+
+// Writes the compact voxel encoding of the Filter output to RootFiles/Compact/Compact_Run_XXXX.root
+// Read it back with VoxelCodec::DefineTPCData on a chain with the CompactTree as friend;
+// Macros/checkCompactVoxels.cxx compares the decoded TPCData with the Filter one
+// Sizes printed are the compressed bytes on disk of the CompactTree and of the Filter TPCData branch
+void runCompactVoxels(double qPrecision = 1, double zPrecision = 0.01,
+                      const std::string& model = "./configs/user/Models/event_classifier.txt",
+                      const std::string& dataconf = "./configs/data.conf")
+{
+    auto flagNames {VoxelCodec::GetFlagNames(model)};
+    ActRoot::DataManager dataman {dataconf, ActRoot::ModeType::EFilter};
+    auto runs {ChainUtils::GetRuns(dataman.GetChain().get())};
+    Long64_t totalCompact {}, totalFilter {};
+    for(auto run : runs)
+    {
+        dataman.SetRuns(run, run);
+        auto chain {dataman.GetChain()};
+
+        auto outname {ChainUtils::GetFileName("./RootFiles/Compact/", "Compact_Run_", run)};
+        auto fout {std::make_unique<TFile>(outname.c_str(), "recreate")};
+        fout->SetCompressionSettings(ROOT::RCompressionSetting::EDefaults::kUseAnalysis);
+        auto* tree {new TTree {"CompactTree", "Compact voxels of Filter"}};
+        VoxelCodec::Data data;
+        data.fQPrecision = qPrecision;
+        data.fZPrecision = zPrecision;
+        data.fFlagNames = flagNames;
+        data.SetBranches(tree);
+
+        TTreeReader reader {chain.get()};
+        TTreeReaderValue<ActRoot::TPCData> tpc {reader, "TPCData"};
+        while(reader.Next())
+        {
+            data.Encode(*tpc);
+            tree->Fill();
+        }
+        fout->cd();
+        tree->Write();
+        auto compact {tree->GetZipBytes()};
+        fout->Close();
+        Long64_t filter {};
+        if(chain->LoadTree(0) >= 0)
+            if(auto* branch {chain->GetTree()->GetBranch("TPCData")})
+                filter = branch->GetZipBytes("*");
+        totalCompact += compact;
+        totalFilter += filter;
+        std::cout << BOLDGREEN << "Run " << run << " -> " << outname << " : " << compact / 1e6 << " MB vs "
+                  << filter / 1e6 << " MB of Filter TPCData" << RESET << '\n';
+        if(data.fNSaturated)
+            std::cout << BOLDRED << "  " << data.fNSaturated << " voxels saturated the charge at 65535 x "
+                      << qPrecision << ": increase qPrecision" << RESET << '\n';
+        if(data.fNZClamped)
+            std::cout << BOLDRED << "  " << data.fNZClamped << " voxels clamped their Z offset at 32767 x "
+                      << zPrecision << ": increase zPrecision" << RESET << '\n';
+    }
+    if(totalFilter)
+        std::cout << BOLDGREEN << "Total : " << totalCompact / 1e6 << " MB vs " << totalFilter / 1e6
+                  << " MB of Filter TPCData (" << 100. * totalCompact / totalFilter << " %)" << RESET << '\n';
+}
@@ -0,0 +1,95 @@
+#include "ActColors.h"
+#include "ActDataManager.h"
+#include "ActInputParser.h"
+#include "ActMergerData.h"
+#include "ActTPCData.h"
+#include "ActTypes.h"
+
+#include "TFile.h"
+#include "TSystem.h"
+#include "TTree.h"
+#include "TTreeReader.h"
+#include "TTreeReaderValue.h"
+
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "./PostAnalysis/ChainUtils.h"
+#include "./configs/user/VMergerHook.h"
+
+// Runs the hooks declared in configs/mergerhooks.conf over the Merger output
+// and writes their columns to RootFiles/Hooks/Hooks_Run_XXXX.root (HookTree, entry-aligned with Merger)
+void runMergerHooks(const std::string& dataconf = "./configs/data.conf",
+                    const std::string& hookconf = "./configs/mergerhooks.conf")
+{
+    // Load hooks
+    ActRoot::InputParser parser {hookconf};
+    std::vector<std::shared_ptr<ActAlgorithm::VMergerHook>> hooks;
+    for(const auto& header : parser.GetBlockHeaders())
+    {
+        if(header.find("Hook") != 0)
+            continue;
+        auto block {parser.GetBlock(header)};
+        auto name {block->GetString("Name")};
+        auto lib {std::string(gSystem->pwd()) + block->GetString("Path") + "lib" + name + ".so"};
+        if(gSystem->Load(lib.c_str()) < 0)
+            throw std::runtime_error("runMergerHooks(): could not load " + lib);
+        auto* sym {gSystem->DynFindSymbol(lib.c_str(), "CreateMergerHook")};
+        if(!sym)
+            throw std::runtime_error("runMergerHooks(): no CreateMergerHook symbol in " + lib);
+        std::shared_ptr<ActAlgorithm::VMergerHook> hook {
+            reinterpret_cast<ActAlgorithm::VMergerHook* (*)()>(sym)()};
+        hook->ReadConfiguration(parser.GetBlock(name));
+        if(!hook->GetIsEnabled())
+            continue;
+        hook->Print();
+        hooks.push_back(hook);
+    }
+    if(hooks.empty())
+    {
+        std::cout << "runMergerHooks(): no enabled hooks" << '\n';
+        return;
+    }
+
+    ActRoot::DataManager dataman {dataconf, ActRoot::ModeType::EMerge};
+    auto runs {ChainUtils::GetRuns(dataman.GetChain().get())};
+    for(auto run : runs)
+    {
+        dataman.SetRuns(run, run);
+        auto chain {dataman.GetChain()};
+        auto chainFilter {dataman.GetChain(ActRoot::ModeType::EFilter)};
+        chain->AddFriend(chainFilter.get());
+
+        // Output
+        auto outname {ChainUtils::GetFileName("./RootFiles/Hooks/", "Hooks_Run_", run)};
+        auto fout {std::make_unique<TFile>(outname.c_str(), "recreate")};
+        auto* tree {new TTree {"HookTree", "Merger hooks tree"}};
+        std::vector<std::vector<double>> values;
+        for(auto& hook : hooks)
+            values.emplace_back(hook->GetColumns().size());
+        for(int h = 0; h < hooks.size(); h++)
+        {
+            auto cols {hooks[h]->GetColumns()};
+            for(int c = 0; c < cols.size(); c++)
+                tree->Branch(cols[c].c_str(), &values[h][c]);
+        }
+
+        // Event loop
+        TTreeReader reader {chain.get()};
+        TTreeReaderValue<ActRoot::MergerData> mer {reader, "MergerData"};
+        TTreeReaderValue<ActRoot::TPCData> tpc {reader, "TPCData"};
+        while(reader.Next())
+        {
+            for(int h = 0; h < hooks.size(); h++)
+                hooks[h]->Run(*mer, *tpc, values[h]);
+            tree->Fill();
+        }
+        fout->cd();
+        tree->Write();
+        fout->Close();
+        std::cout << BOLDGREEN << "Run " << run << " -> " << outname << RESET << '\n';
+    }
+}
@@ -0,0 +1,76 @@
+#include "ActColors.h"
+#include "ActDataManager.h"
+#include "ActMergerData.h"
+#include "ActModularData.h"
+#include "ActTypes.h"
+
+#include "ROOT/RDF/HistoModels.hxx"
+#include "ROOT/RDataFrame.hxx"
+#include "ROOT/RResultPtr.hxx"
+#include "ROOT/RVec.hxx"
+
+#include "TFile.h"
+#include "TH1D.h"
+#include "TH2D.h"
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "./PostAnalysis/ChainUtils.h"
+#include "./PostAnalysis/ClusterSummary.h"
+
+// Quick-look spectra of Pipe0 (beam ID, GATCONF) and Pipe1 (PID) for one run, written to
+// RootFiles/Nearline/Spectra_Run_XXXX.root; doNearline.sh adds them into Spectra_Sum.root with hadd
+void runNearlineSpectra(int run, const std::string& dataconf = "./configs/data.conf")
+{
+    ActRoot::DataManager dataman {dataconf, ActRoot::ModeType::EReadSilMod};
+    dataman.SetRuns(run, run);
+    auto chain {dataman.GetChain()};
+    auto chainMerger {dataman.GetChain(ActRoot::ModeType::EMerge)};
+    chain->AddFriend(chainMerger.get());
+    auto chainSummary {ChainUtils::GetSidecar(chainMerger.get(), "./RootFiles/Summary/", "Summary_Run_", "SummaryTree")};
+    chain->AddFriend(chainSummary.get());
+
+    ROOT::EnableImplicitMT();
+    ROOT::RDataFrame df {*chain};
+    auto defGat {df.Define("GATCONF", [](ActRoot::ModularData& mod) { return static_cast<int>(mod.Get("GATCONF")); },
+                           {"ModularData"})};
+
+    // Pipe0
+    auto hGATCONF {defGat.Histo1D({"hGATCONF", "GATCONF;GATCONF", 600, 0, 600}, "GATCONF")};
+    auto hdEE {defGat.Filter("fBeamIdx != -1")
+                   .Define("dE", [](const ROOT::RVecF& qprofile, int beamIdx)
+                           { return ClusterSummary::GetQBelow(qprofile, beamIdx, 10); }, {"QProfile", "fBeamIdx"})
+                   .Define("E", [](const ROOT::RVecF& q, int beamIdx) { return (double)q[beamIdx]; }, {"Q", "fBeamIdx"})
+                   .Histo2D({"hdEE", "Beam ID;Q_{total} [au];Q_{10 pads} [au]", 300, 0, 1e5, 300, 0, 1e5}, "E", "dE")};
+
+    // Pipe1: gas-silicon PID per layer and L1 PID
+    std::vector<ROOT::RDF::RResultPtr<TH2D>> hs;
+    for(const std::string layer : {"f0", "l0", "r0"})
+        hs.push_back(
+            defGat
+                .Filter([=](ActRoot::MergerData& m)
+                        { return m.fLight.GetNLayers() == 1 && m.fLight.GetLayer(0) == layer; }, {"MergerData"})
+                .Define("ESil", [](ActRoot::MergerData& m) { return m.fLight.fEs.front(); }, {"MergerData"})
+                .Define("Qave", [](ActRoot::MergerData& m) { return m.fLight.fQave; }, {"MergerData"})
+                .Histo2D({("hGasSil_" + layer).c_str(), (layer + ";E_{Sil} [MeV];#Delta E_{gas} [arb. units]").c_str(),
+                          450, 0, 70, 600, 0, 3000},
+                         "ESil", "Qave"));
+    auto hl1 {defGat.Filter("GATCONF == 8 && fLightIdx != -1")
+                  .Define("RawTL", [](ActRoot::MergerData& m) { return m.fLight.fRawTL; }, {"MergerData"})
+                  .Define("Qtotal", [](ActRoot::MergerData& m) { return m.fLight.fQtotal; }, {"MergerData"})
+                  .Histo2D({"hl1", "L1 PID;Raw TL [au];Q_{total} [au]", 200, 0, 120, 2000, 0, 3e5}, "RawTL", "Qtotal")};
+
+    auto outname {ChainUtils::GetFileName("./RootFiles/Nearline/", "Spectra_Run_", run)};
+    auto fout {std::make_unique<TFile>(outname.c_str(), "recreate")};
+    hGATCONF->Write();
+    hdEE->Write();
+    for(auto& h : hs)
+        h->Write();
+    hl1->Write();
+    fout->Close();
+    std::cout << BOLDGREEN << "Run " << run << " -> " << outname << RESET << '\n';
+}
@@ -0,0 +1,82 @@
+#include "ActColors.h"
+#include "ActDataManager.h"
+#include "ActInputParser.h"
+#include "ActMergerData.h"
+#include "ActModularData.h"
+#include "ActTPCData.h"
+#include "ActTypes.h"
+
+#include "ROOT/RDF/RInterface.hxx"
+#include "ROOT/RDataFrame.hxx"
+#include "ROOT/RResultPtr.hxx"
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "./PostAnalysis/ChainUtils.h"
+#include "./PostAnalysis/IOConfig.h"
+
+// Writes the skims of configs/skims.conf, all of them in a single event loop per run
+void runSkims(const std::string& dataconf = "./configs/data.conf", const std::string& skimconf = "./configs/skims.conf")
+{
+    ActRoot::InputParser parser {skimconf};
+    auto names {parser.GetBlockHeaders()};
+
+    ActRoot::DataManager dataman {dataconf, ActRoot::ModeType::EReadSilMod};
+    auto runs {ChainUtils::GetRuns(dataman.GetChain().get())};
+    for(auto run : runs)
+    {
+        dataman.SetRuns(run, run);
+        // Filter chain first so TPCData is the filtered one; ModularData and SilData from the Data stage;
+        // the Cluster stage clusters (before the filter actions) as Cluster.TPCData
+        auto chain {dataman.GetChain(ActRoot::ModeType::EFilter)};
+        auto chainMerger {dataman.GetChain(ActRoot::ModeType::EMerge)};
+        chain->AddFriend(chainMerger.get());
+        auto chainData {dataman.GetChain()};
+        chain->AddFriend(chainData.get());
+        auto chainCluster {dataman.GetChain(ActRoot::ModeType::EReadTPC)};
+        chain->AddFriend(chainCluster.get(), "Cluster");
+
+        ROOT::RDataFrame d {*chain};
+        auto df {d.Define("GATCONF", [](ActRoot::ModularData& mod) { return (int)mod.Get("GATCONF"); }, {"ModularData"})
+                     .Define("NClusters", [](ActRoot::TPCData& tpc) { return (int)tpc.fClusters.size(); }, {"TPCData"})
+                     .Define("ClusterNClusters", [](ActRoot::TPCData& tpc) { return (int)tpc.fClusters.size(); },
+                             {"Cluster.TPCData"})};
+
+        // Book all skims lazily
+        auto opts {IOConfig::GetSnapshotOptions()};
+        opts.fLazy = true;
+        opts.fSplitLevel = 99; // member sub-branches, as in the analysis tree
+        std::vector<ROOT::RDF::RResultPtr<ROOT::RDF::RInterface<ROOT::Detail::RDF::RLoopManager>>> snaps;
+        for(const auto& name : names)
+        {
+            auto block {parser.GetBlock(name)};
+            std::vector<int> gats, mults;
+            if(block->CheckTokenExists("Gatconf"))
+                gats = block->GetIntVector("Gatconf");
+            if(block->CheckTokenExists("NClusters"))
+                mults = block->GetIntVector("NClusters");
+            bool requireLight {block->CheckTokenExists("RequireLight") && block->GetBool("RequireLight")};
+            auto node {df.Filter(
+                [=](int gatconf, int nclusters, int lightIdx)
+                {
+                    if(gats.size() && std::find(gats.begin(), gats.end(), gatconf) == gats.end())
+                        return false;
+                    if(mults.size() && std::find(mults.begin(), mults.end(), nclusters) == mults.end())
+                        return false;
+                    if(requireLight && lightIdx == -1)
+                        return false;
+                    return true;
+                },
+                {"GATCONF", "NClusters", "fLightIdx"})};
+            auto outname {ChainUtils::GetFileName("./RootFiles/Skims/", name + "_Run_", run)};
+            snaps.push_back(node.Snapshot("SkimTree", outname, block->GetStringVector("Branches"), opts));
+        }
+        // Trigger the event loop once
+        for(auto& snap : snaps)
+            snap.GetValue();
+        std::cout << BOLDGREEN << "Run " << run << " -> " << names.size() << " skims" << RESET << '\n';
+    }
+}
@@ -0,0 +1,67 @@
+#include "ActColors.h"
+#include "ActDataManager.h"
+#include "ActMergerData.h"
+#include "ActModularData.h"
+#include "ActTPCData.h"
+#include "ActTypes.h"
+
+#include "TFile.h"
+#include "TList.h"
+#include "TParameter.h"
+#include "TTree.h"
+#include "TTreeReader.h"
+#include "TTreeReaderValue.h"
+
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "./PostAnalysis/ChainUtils.h"
+#include "./PostAnalysis/ZoneMaps.h"
+
+// Writes the zone maps and event flags of each Merger file to RootFiles/ZoneMaps/ZoneMaps_Run_XXXX.root
+// Select events with ZoneMaps::Index and apply the resulting EventList to the chains
+void runZoneMaps(const std::string& dataconf = "./configs/data.conf")
+{
+    ActRoot::DataManager dataman {dataconf, ActRoot::ModeType::EMerge};
+    auto runs {ChainUtils::GetRuns(dataman.GetChain().get())};
+    for(auto run : runs)
+    {
+        dataman.SetRuns(run, run);
+        auto chain {dataman.GetChain()};
+        auto chainData {dataman.GetChain(ActRoot::ModeType::EReadSilMod)};
+        chain->AddFriend(chainData.get());
+        auto chainFilter {dataman.GetChain(ActRoot::ModeType::EFilter)};
+        chain->AddFriend(chainFilter.get());
+
+        auto outname {ChainUtils::GetFileName("./RootFiles/ZoneMaps/", "ZoneMaps_Run_", run)};
+        auto fout {std::make_unique<TFile>(outname.c_str(), "recreate")};
+        auto* tree {new TTree {"ZoneTree", "Zone maps and event flags of Merger"}};
+        tree->GetUserInfo()->Add(new TParameter<int> {"Version", ZoneMaps::kVersion});
+        ZoneMaps::Block block;
+        block.SetBranches(tree);
+
+        TTreeReader reader {chain.get()};
+        TTreeReaderValue<ActRoot::MergerData> mer {reader, "MergerData"};
+        TTreeReaderValue<ActRoot::ModularData> mod {reader, "ModularData"};
+        TTreeReaderValue<ActRoot::TPCData> tpc {reader, "TPCData"};
+        std::int64_t entry {};
+        block.Clear(run, 0);
+        while(reader.Next())
+        {
+            block.Add(*mer, *mod, *tpc);
+            entry++;
+            if(block.fFlags.size() == ZoneMaps::kBlockSize)
+            {
+                tree->Fill();
+                block.Clear(run, entry);
+            }
+        }
+        if(block.fFlags.size())
+            tree->Fill();
+        fout->cd();
+        tree->Write();
+        fout->Close();
+        std::cout << BOLDGREEN << "Run " << run << " -> " << outname << RESET << '\n';
+    }
+}